@@ -9,6 +9,7 @@
  */
 
 #include <labtransformations/cubeanimator.h>
+#include <labtransformations/meshview.h>
 
 namespace inviwo
 {
@@ -55,12 +56,11 @@ CubeAnimator::CubeAnimator()
 
 void CubeAnimator::process()
 {
-    // Clone the input mesh
     if (!meshIn_.getData()) return;
-    auto mesh = meshIn_.getData()->clone();
+    const Mesh& meshIn = *meshIn_.getData();
 
     // Get the matrix that defines where the mesh is currently
-    auto matrix = mesh->getWorldMatrix();
+    auto matrix = meshIn.getWorldMatrix();
 
 
     // Transform the mesh (TODO)
@@ -91,11 +91,8 @@ void CubeAnimator::process()
     //glm::rot
     //glm::rot
 
-    // Update
-    mesh->setWorldMatrix(matrix);
-	
-    // Set output
-    meshOut_.setData(mesh);
+    // Set output: the input buffers with the updated matrix, without copying them
+    meshOut_.setData(util::makeMeshView(meshIn, matrix));
 }
 
 } // namespace
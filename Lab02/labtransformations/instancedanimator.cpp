@@ -0,0 +1,100 @@
+/*********************************************************************
+ *  Author  : Himangshu Saikia
+ *  Init    : Sunday, October 18, 2026 - 03:41:08
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#include <labtransformations/instancedanimator.h>
+#include <labtransformations/meshview.h>
+#include <inviwo/core/datastructures/buffer/buffer.h>
+
+namespace inviwo
+{
+
+// The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
+const ProcessorInfo InstancedAnimator::processorInfo_
+{
+    "org.inviwo.InstancedAnimator",      // Class identifier
+    "Instanced Animator",                // Display name
+    "KTH Labs",                 // Category
+    CodeState::Experimental,  // Code state
+    Tags::None,               // Tags
+};
+
+const ProcessorInfo InstancedAnimator::getProcessorInfo() const
+{
+    return processorInfo_;
+}
+
+
+InstancedAnimator::InstancedAnimator()
+    :Processor()
+    // Ports
+    , meshIn_("meshIn")
+    , meshOut_("meshOut")
+    , instanceMatricesOut_("instanceMatricesOut")
+    // Properties
+    , numInstances_("numInstances", "Instances", 1000, 1, 100000)
+    , radius_("radius", "Radius", 6, 0, 100)
+    , radiusStep_("radiusStep", "Radius Step", 0.01f, 0, 1)
+    , rotation_("rotation", "Rotation", 0, 0, 8)
+    , delta_("delta", "delta", 0, 0, 1)
+    , spinStep_("spinStep", "Spin Step", 0.001f, 0, 0.1f)
+    {
+    // Add ports
+    addPort(meshIn_);
+    addPort(meshOut_);
+    addPort(instanceMatricesOut_);
+
+    // Add properties
+    addProperty(numInstances_);
+    addProperty(radius_);
+    addProperty(radiusStep_);
+    addProperty(rotation_);
+    addProperty(delta_);
+    addProperty(spinStep_);
+}
+
+
+void InstancedAnimator::process()
+{
+    if (!meshIn_.getData()) return;
+    const Mesh& meshIn = *meshIn_.getData();
+    const mat4 worldMatrix = meshIn.getWorldMatrix();
+
+    const size_t numInstances = static_cast<size_t>(numInstances_.get());
+    const float twoPi = 2.0f * glm::pi<float>();
+
+    // The same for all instances: where all of them have moved along their orbits
+    const mat4 orbitMatrix = glm::rotate(rotation_.get(), vec3(0, 0, 1));
+
+    // One matrix per instance, stored as four columns
+    std::vector<vec4> instanceMatrices(4 * numInstances);
+    for (size_t i(0); i < numInstances; i++)
+    {
+        const float startAngle = twoPi * float(i) / float(numInstances);
+        const float orbitRadius = radius_.get() + radiusStep_.get() * float(i);
+        const float spin = twoPi * delta_.get() * (1.0f + spinStep_.get() * float(i));
+
+        const mat4 matrix = orbitMatrix
+                          * glm::rotate(startAngle, vec3(0, 0, 1))
+                          * glm::translate(vec3(orbitRadius, 0, 0))
+                          * glm::rotate(spin, vec3(0, 0, 1))
+                          * worldMatrix;
+        for (int c(0); c < 4; c++)
+        {
+            instanceMatrices[4 * i + c] = matrix[c];
+        }
+    }
+
+    // Set output: the mesh once, and all instance matrices in one buffer.
+    // The instance matrices contain the world matrix, so the mesh must not apply it again.
+    meshOut_.setData(util::makeMeshView(meshIn, mat4(1)));
+    instanceMatricesOut_.setData(util::makeBuffer(std::move(instanceMatrices)));
+}
+
+} // namespace
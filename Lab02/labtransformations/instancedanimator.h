@@ -0,0 +1,98 @@
+/*********************************************************************
+ *  Author  : Himangshu Saikia
+ *  Init    : Sunday, October 18, 2026 - 03:41:08
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#pragma once
+
+#include <labtransformations/labtransformationsmoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/ports/meshport.h>
+#include <inviwo/core/ports/bufferport.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+
+namespace inviwo
+{
+
+/** \docpage{org.inviwo.InstancedAnimator, Instanced Animator}
+    ![](org.inviwo.InstancedAnimator.png?classIdentifier=org.inviwo.InstancedAnimator)
+
+    Animates many instances of one mesh on circular orbits, like the Cube Animator
+    does for a single mesh. Instead of one mesh per object, it outputs the mesh once
+    together with one transformation matrix per instance, for instanced rendering.
+
+    Instance i starts at the angle 2 pi i / N on its orbit. Its orbit radius grows by
+    the radius step per instance, and its own spin by the spin step per instance.
+
+    ### Inports
+      * __meshIn__ Input mesh.
+
+    ### Outports
+      * __meshOut__ The input mesh, sharing its buffers, with an identity world matrix.
+      * __instanceMatricesOut__ Buffer of vec4 with the four columns of the world matrix
+        of every instance, instance after instance. These include the world matrix of
+        the input mesh. The Instance Merger turns them into one mesh for any renderer.
+
+    ### Properties
+      * __numInstances__ Number of instances N.
+      * __radius__ Radius of the orbit of the first instance.
+      * __radiusStep__ Radius added for every further instance.
+      * __rotation__ Angle by which all instances have moved along their orbits.
+      * __delta__ Spin of every instance around its own z-axis, in turns.
+      * __spinStep__ Spin added for every further instance, as a multiple of delta.
+*/
+
+
+/** \class InstancedAnimator
+    \brief Orbit animation of many instances of one mesh
+
+    @author Himangshu Saikia
+*/
+class IVW_MODULE_LABTRANSFORMATIONS_API InstancedAnimator : public Processor
+{
+//Friends
+//Types
+public:
+
+//Construction / Deconstruction
+public:
+    InstancedAnimator();
+    virtual ~InstancedAnimator() = default;
+
+//Methods
+public:
+    virtual const ProcessorInfo getProcessorInfo() const override;
+    static const ProcessorInfo processorInfo_;
+
+protected:
+    ///Our main computation function
+    virtual void process() override;
+
+//Ports
+public:
+    MeshInport meshIn_;
+    MeshOutport meshOut_;
+    BufferOutport instanceMatricesOut_;
+
+//Properties
+public:
+    IntProperty numInstances_;
+    FloatProperty radius_;
+    FloatProperty radiusStep_;
+    FloatProperty rotation_;
+    FloatProperty delta_;
+    FloatProperty spinStep_;
+
+
+//Attributes
+private:
+
+};
+
+} // namespace
@@ -0,0 +1,234 @@
+/*********************************************************************
+ *  Author  : Himangshu Saikia
+ *  Init    : Saturday, October 17, 2026 - 23:58:14
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#include <labtransformations/instancemerger.h>
+#include <inviwo/core/datastructures/buffer/buffer.h>
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace inviwo
+{
+
+namespace
+{
+
+/*  The size values of a vertex attribute as T, read once through the getter get(v),
+    so that the virtual accessors of the buffer are not called for every instance.
+*/
+template <typename T, typename Getter>
+std::vector<T> readAttribute(const size_t size, Getter get)
+{
+    std::vector<T> values(size);
+    for (size_t v(0); v < size; v++)
+    {
+        values[v] = get(v);
+    }
+    return values;
+}
+
+/*  One copy of a vertex attribute with size values per instance, value v of instance i
+    given by get(i, v). The attributes are stored as floats, whatever their input type.
+*/
+template <typename T, typename Getter>
+std::shared_ptr<BufferBase> repeatAttribute(const size_t numInstances, const size_t size,
+                                            Getter get)
+{
+    std::vector<T> values(numInstances * size);
+    for (size_t i(0); i < numInstances; i++)
+    {
+        for (size_t v(0); v < size; v++)
+        {
+            values[i * size + v] = get(i, v);
+        }
+    }
+    return util::makeBuffer(std::move(values));
+}
+
+/*  The same values for every instance.
+*/
+template <typename T>
+std::shared_ptr<BufferBase> repeatValues(const size_t numInstances, const std::vector<T>& values)
+{
+    return repeatAttribute<T>(numInstances, values.size(),
+                              [&](size_t, size_t v) { return values[v]; });
+}
+
+} // namespace
+
+// The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
+const ProcessorInfo InstanceMerger::processorInfo_
+{
+    "org.inviwo.InstanceMerger",      // Class identifier
+    "Instance Merger",                // Display name
+    "KTH Labs",                 // Category
+    CodeState::Experimental,  // Code state
+    Tags::None,               // Tags
+};
+
+const ProcessorInfo InstanceMerger::getProcessorInfo() const
+{
+    return processorInfo_;
+}
+
+
+InstanceMerger::InstanceMerger()
+    :Processor()
+    // Ports
+    , meshIn_("meshIn")
+    , instanceMatricesIn_("instanceMatricesIn")
+    , meshOut_("meshOut")
+    {
+    // Add ports
+    addPort(meshIn_);
+    addPort(instanceMatricesIn_);
+    addPort(meshOut_);
+}
+
+
+void InstanceMerger::process()
+{
+    if (!meshIn_.getData() || !instanceMatricesIn_.getData()) return;
+    const Mesh& meshIn = *meshIn_.getData();
+    const auto matricesRam = instanceMatricesIn_.getData()->getRepresentation<BufferRAM>();
+    if (!matricesRam || matricesRam->getDataFormat()->getComponents() != 4) return;
+
+    // One matrix per instance, stored as four columns, applied after the model matrix
+    const size_t numInstances = matricesRam->getSize() / 4;
+    const mat4 modelMatrix = meshIn.getModelMatrix();
+    std::vector<mat4> pointMatrices(numInstances);
+    std::vector<mat3> normalMatrices(numInstances);
+    for (size_t i(0); i < numInstances; i++)
+    {
+        mat4 instanceMatrix;
+        for (int c(0); c < 4; c++)
+        {
+            instanceMatrix[c] = vec4(matricesRam->getAsDVec4(4 * i + c));
+        }
+        pointMatrices[i] = instanceMatrix * modelMatrix;
+        normalMatrices[i] = glm::transpose(glm::inverse(mat3(pointMatrices[i])));
+    }
+
+    // Copies are appended to each other, so every attribute needs one value per vertex
+    // and the indices of a copy must not connect to the previous one
+    const size_t numVertices =
+        meshIn.getBuffers().empty() ? 0 : meshIn.getBuffers().front().second->getSize();
+    for (const auto& buffer : meshIn.getBuffers())
+    {
+        if (buffer.second->getSize() != numVertices)
+        {
+            LogError("All vertex attributes need the same size, got " << numVertices
+                     << " and " << buffer.second->getSize());
+            return;
+        }
+    }
+    for (const auto& indexBuffer : meshIn.getIndexBuffers())
+    {
+        if (indexBuffer.first.ct != ConnectivityType::None)
+        {
+            LogError("Only index buffers without connectivity (lists) can be merged; "
+                     "strips, fans, loops and adjacency would join the copies");
+            return;
+        }
+    }
+    if (numInstances * numVertices > std::numeric_limits<uint32_t>::max())
+    {
+        LogError("Too many vertices for 32-bit indices: " << numInstances * numVertices);
+        return;
+    }
+
+    auto meshOut = std::make_shared<Mesh>(meshIn.getDefaultMeshInfo());
+    for (const auto& buffer : meshIn.getBuffers())
+    {
+        const auto ram = buffer.second->getRepresentation<BufferRAM>();
+        if (!ram) continue;
+        const size_t size = ram->getSize();
+        const size_t components = ram->getDataFormat()->getComponents();
+
+        // Positions and normals are moved with every instance, the rest is copied
+        std::shared_ptr<BufferBase> bufferOut;
+        if (buffer.first.type == BufferType::PositionAttrib && components == 3)
+        {
+            const auto positions = readAttribute<vec3>(size, [&](size_t v)
+            {
+                return vec3(ram->getAsDVec3(v));
+            });
+            bufferOut = repeatAttribute<vec3>(numInstances, size, [&](size_t i, size_t v)
+            {
+                const vec4 position = pointMatrices[i] * vec4(positions[v], 1.0f);
+                return vec3(position) / position.w;
+            });
+        }
+        else if (buffer.first.type == BufferType::NormalAttrib && components == 3)
+        {
+            const auto normals = readAttribute<vec3>(size, [&](size_t v)
+            {
+                return vec3(ram->getAsDVec3(v));
+            });
+            bufferOut = repeatAttribute<vec3>(numInstances, size, [&](size_t i, size_t v)
+            {
+                return glm::normalize(normalMatrices[i] * normals[v]);
+            });
+        }
+        else
+        {
+            switch (components)
+            {
+                case 1:
+                    bufferOut = repeatValues(numInstances, readAttribute<float>(size, [&](size_t v)
+                    {
+                        return static_cast<float>(ram->getAsDouble(v));
+                    }));
+                    break;
+                case 2:
+                    bufferOut = repeatValues(numInstances, readAttribute<vec2>(size, [&](size_t v)
+                    {
+                        return vec2(ram->getAsDVec2(v));
+                    }));
+                    break;
+                case 3:
+                    bufferOut = repeatValues(numInstances, readAttribute<vec3>(size, [&](size_t v)
+                    {
+                        return vec3(ram->getAsDVec3(v));
+                    }));
+                    break;
+                default:
+                    bufferOut = repeatValues(numInstances, readAttribute<vec4>(size, [&](size_t v)
+                    {
+                        return vec4(ram->getAsDVec4(v));
+                    }));
+                    break;
+            }
+        }
+        meshOut->addBuffer(buffer.first, bufferOut);
+    }
+
+    // Every copy indexes its own vertices
+    for (const auto& indexBuffer : meshIn.getIndexBuffers())
+    {
+        const auto& indices = indexBuffer.second->getRAMRepresentation()->getDataContainer();
+        std::vector<uint32_t> indicesOut(numInstances * indices.size());
+        for (size_t i(0); i < numInstances; i++)
+        {
+            const uint32_t offset = static_cast<uint32_t>(i * numVertices);
+            for (size_t j(0); j < indices.size(); j++)
+            {
+                indicesOut[i * indices.size() + j] = indices[j] + offset;
+            }
+        }
+        meshOut->addIndices(indexBuffer.first, util::makeIndexBuffer(std::move(indicesOut)));
+    }
+
+    meshOut->copyMetaDataFrom(meshIn);
+    meshOut_.setData(meshOut);
+}
+
+} // namespace
@@ -0,0 +1,83 @@
+/*********************************************************************
+ *  Author  : Himangshu Saikia
+ *  Init    : Saturday, October 17, 2026 - 23:58:14
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#pragma once
+
+#include <labtransformations/labtransformationsmoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/ports/meshport.h>
+#include <inviwo/core/ports/bufferport.h>
+
+namespace inviwo
+{
+
+/** \docpage{org.inviwo.InstanceMerger, Instance Merger}
+    ![](org.inviwo.InstanceMerger.png?classIdentifier=org.inviwo.InstanceMerger)
+
+    Places one copy of a mesh at every instance matrix and merges all copies into a
+    single mesh, which any mesh renderer draws in one call. This is the consumer of the
+    Instanced Animator for renderers without instancing.
+
+    Positions and normals are transformed with the instance matrix and the model matrix
+    of the mesh; all other vertex attributes are copied. The index buffers of the copies
+    are appended to each other, one index buffer per index buffer of the input. The
+    output has identity model and world matrices.
+
+    All vertex attributes need the same number of values, and index buffers need to be
+    lists (ConnectivityType::None): a strip or loop would connect each copy to the next.
+
+    ### Inports
+      * __meshIn__ Mesh to be instanced.
+      * __instanceMatricesIn__ Buffer of vec4 with the four columns of the world matrix
+        of every instance, instance after instance.
+
+    ### Outports
+      * __meshOut__ All instances in one mesh.
+*/
+
+
+/** \class InstanceMerger
+    \brief Merges all instances of a mesh into one mesh
+
+    @author Himangshu Saikia
+*/
+class IVW_MODULE_LABTRANSFORMATIONS_API InstanceMerger : public Processor
+{
+//Friends
+//Types
+public:
+
+//Construction / Deconstruction
+public:
+    InstanceMerger();
+    virtual ~InstanceMerger() = default;
+
+//Methods
+public:
+    virtual const ProcessorInfo getProcessorInfo() const override;
+    static const ProcessorInfo processorInfo_;
+
+protected:
+    ///Our main computation function
+    virtual void process() override;
+
+//Ports
+public:
+    MeshInport meshIn_;
+    BufferInport instanceMatricesIn_;
+    MeshOutport meshOut_;
+
+//Attributes
+private:
+
+};
+
+} // namespace
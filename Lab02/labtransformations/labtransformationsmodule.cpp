@@ -10,6 +10,9 @@
 
 #include <labtransformations/labtransformationsmodule.h>
 #include <labtransformations/cubeanimator.h>
+#include <labtransformations/instancedanimator.h>
+#include <labtransformations/instancemerger.h>
+#include <labtransformations/transformstack.h>
 
 namespace inviwo
 {
@@ -18,6 +21,9 @@ LabTransformationsModule::LabTransformationsModule(InviwoApplication* app) : Inv
 
 {
 	registerProcessor<CubeAnimator>();
+	registerProcessor<InstancedAnimator>();
+	registerProcessor<InstanceMerger>();
+	registerProcessor<TransformStack>();
 }
 
 } // namespace
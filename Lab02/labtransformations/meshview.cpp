@@ -0,0 +1,39 @@
+/*********************************************************************
+ *  Author  : Himangshu Saikia
+ *  Init    : Sunday, October 18, 2026 - 03:14:26
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#include <labtransformations/meshview.h>
+
+namespace inviwo
+{
+namespace util
+{
+
+std::shared_ptr<Mesh> makeMeshView(const Mesh& source, const mat4& worldMatrix)
+{
+    auto mesh = std::make_shared<Mesh>(source.getDefaultMeshInfo());
+
+    // Share the buffers instead of copying them
+    for (const auto& buffer : source.getBuffers())
+    {
+        mesh->addBuffer(buffer.first, buffer.second);
+    }
+    for (const auto& indexBuffer : source.getIndexBuffers())
+    {
+        mesh->addIndices(indexBuffer.first, indexBuffer.second);
+    }
+
+    mesh->copyMetaDataFrom(source);
+    mesh->setModelMatrix(source.getModelMatrix());
+    mesh->setWorldMatrix(worldMatrix);
+    return mesh;
+}
+
+} // namespace
+} // namespace
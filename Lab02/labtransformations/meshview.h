@@ -0,0 +1,34 @@
+/*********************************************************************
+ *  Author  : Himangshu Saikia
+ *  Init    : Sunday, October 18, 2026 - 03:14:26
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#pragma once
+
+#include <labtransformations/labtransformationsmoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/geometry/mesh.h>
+
+namespace inviwo
+{
+namespace util
+{
+
+/** Creates a mesh that shares all vertex and index buffers of the given mesh,
+    but has its own world matrix.
+
+    Only the buffer handles are copied, so this costs the same for a cube and for a
+    mesh with millions of vertices. Meshes travel as const data between processors:
+    a processor downstream that wants to change the buffers has to clone the mesh,
+    which leaves the shared buffers untouched.
+*/
+IVW_MODULE_LABTRANSFORMATIONS_API std::shared_ptr<Mesh> makeMeshView(const Mesh& source,
+                                                                     const mat4& worldMatrix);
+
+} // namespace
+} // namespace
@@ -0,0 +1,62 @@
+/*********************************************************************
+ *  Author  : Himangshu Saikia
+ *  Init    : Sunday, October 18, 2026 - 04:05:52
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#include <labtransformations/transformstack.h>
+#include <labtransformations/meshview.h>
+
+namespace inviwo
+{
+
+// The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
+const ProcessorInfo TransformStack::processorInfo_
+{
+    "org.inviwo.TransformStack",      // Class identifier
+    "Transform Stack",                // Display name
+    "KTH Labs",                 // Category
+    CodeState::Experimental,  // Code state
+    Tags::None,               // Tags
+};
+
+const ProcessorInfo TransformStack::getProcessorInfo() const
+{
+    return processorInfo_;
+}
+
+
+TransformStack::TransformStack()
+    :Processor()
+    // Ports
+    , meshIn_("meshIn")
+    , meshOut_("meshOut")
+    // Properties
+    , transforms_("transforms", "Transforms")
+    {
+    // Add ports
+    addPort(meshIn_);
+    addPort(meshOut_);
+
+    // Add properties
+    addProperty(transforms_);
+}
+
+
+void TransformStack::process()
+{
+    if (!meshIn_.getData()) return;
+    const Mesh& meshIn = *meshIn_.getData();
+
+    // Fold the list into one matrix; this is cheap next to a processor per transformation
+    const mat4 stackMatrix = transforms_.getMatrix();
+
+    // Set output: the input buffers with all transformations applied in one matrix
+    meshOut_.setData(util::makeMeshView(meshIn, stackMatrix * meshIn.getWorldMatrix()));
+}
+
+} // namespace
@@ -0,0 +1,80 @@
+/*********************************************************************
+ *  Author  : Himangshu Saikia
+ *  Init    : Sunday, October 18, 2026 - 04:05:52
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#pragma once
+
+#include <labtransformations/labtransformationsmoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/ports/meshport.h>
+#include <modules/base/properties/transformlistproperty.h>
+
+namespace inviwo
+{
+
+/** \docpage{org.inviwo.TransformStack, Transform Stack}
+    ![](org.inviwo.TransformStack.png?classIdentifier=org.inviwo.TransformStack)
+
+    Applies a whole list of transformations to a mesh in one step. It replaces a chain
+    of Transform Mesh processors: the list is folded into a single matrix, and only that
+    matrix is applied to the mesh.
+
+    ### Inports
+      * __meshIn__ Input mesh.
+
+    ### Outports
+      * __meshOut__ The input mesh, sharing its buffers, with the transformed world matrix.
+
+    ### Properties
+      * __transforms__ Transformations, applied to the world matrix of the mesh in order.
+*/
+
+
+/** \class TransformStack
+    \brief Folds a chain of mesh transformations into one matrix
+
+    @author Himangshu Saikia
+*/
+class IVW_MODULE_LABTRANSFORMATIONS_API TransformStack : public Processor
+{
+//Friends
+//Types
+public:
+
+//Construction / Deconstruction
+public:
+    TransformStack();
+    virtual ~TransformStack() = default;
+
+//Methods
+public:
+    virtual const ProcessorInfo getProcessorInfo() const override;
+    static const ProcessorInfo processorInfo_;
+
+protected:
+    ///Our main computation function
+    virtual void process() override;
+
+//Ports
+public:
+    MeshInport meshIn_;
+    MeshOutport meshOut_;
+
+//Properties
+public:
+    TransformListProperty transforms_;
+
+
+//Attributes
+private:
+
+};
+
+} // namespace
@@ -9,6 +9,16 @@
  */
 
 #include <modules/labsubdivision/chaikin.h>
+#include <modules/labsubdivision/chaikinsubdivision.h>
+#include <modules/labsubdivision/polylinestream.h>
+#include <modules/labsubdivision/workranges.h>
+#include <inviwo/core/common/inviwoapplication.h>
+
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <limits>
+#include <numeric>
 
 namespace inviwo
 {
@@ -36,10 +46,58 @@ Chaikin::Chaikin()
     ,portInLines("InLines")
     ,portOutLines("OutLines")
     ,propMinNumDesiredPoints("MinNumDesiredPoints", "Num Points", 100, 1, 200, 1)
+    ,propMode("Mode", "Mode")
+    ,propTolerance("Tolerance", "Tolerance", 0.001f, 0.00001f, 0.1f, 0.00001f)
+    ,propInFile("InFile", "Polyline File")
+    ,propOutFile("OutFile", "Subdivided File")
+    ,propSubdivideFile("SubdivideFile", "Subdivide File")
 {
     addPort(portInLines);
     addPort(portOutLines);
     addProperty(propMinNumDesiredPoints);
+    propMode.addOption("CornerCutting", "Corner Cutting", 0);
+    propMode.addOption("LimitCurve", "Limit Curve", 1);
+    propMode.addOption("Adaptive", "Adaptive Limit Curve", 2);
+    addProperty(propMode);
+    addProperty(propTolerance);
+
+    //Polyline files are streamed from disk to disk, not through the ports
+    propOutFile.setAcceptMode(AcceptMode::Save);
+    addProperty(propInFile);
+    addProperty(propOutFile);
+    addProperty(propSubdivideFile);
+    propSubdivideFile.onChange([this]() { SubdivideFile(); });
+}
+
+void Chaikin::SubdivideFile()
+{
+    if (FileJob.valid() && FileJob.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+        LogWarn("Still subdividing " << propInFile.get() << ", try again when it is done");
+        return;
+    }
+
+    //Streaming a large file takes long, so it runs as a job on Inviwo's thread pool
+    //instead of blocking the user interface. The job gets copies of all settings and
+    //does not touch the processor, which may be changed or deleted while it runs.
+    const std::string InPath = propInFile.get();
+    const std::string OutPath = propOutFile.get();
+    const auto SubdivisionMethod = static_cast<ChaikinSubdivision::Method>(propMode.get());
+    const size_t MinNumPoints = propMinNumDesiredPoints.get();
+    const float Tolerance = propTolerance.get();
+    LogInfo("Subdividing " << InPath << " into " << OutPath);
+    FileJob = dispatchPool([InPath, OutPath, SubdivisionMethod, MinNumPoints, Tolerance]()
+    {
+        if (SubdividePolylineFile(InPath, OutPath, mat4(1), SubdivisionMethod, MinNumPoints,
+                                  Tolerance))
+        {
+            LogInfoCustom("Chaikin", "Subdivided " << InPath << " into " << OutPath);
+        }
+        else
+        {
+            LogErrorCustom("Chaikin", "Could not subdivide " << InPath << " into " << OutPath);
+        }
+    });
 }
 
 /*  Applies Chaikin's Corner Cutting algorithm.
@@ -52,37 +110,9 @@ void Chaikin::CornerCutting(const std::vector<vec3>& ControlPolygon,
                             const size_t MinNumDesiredPoints,
                             std::vector<vec3>& Curve)
 {
-    //TODO: Extend and edit this code
-    Curve.clear();
-
-    const size_t NumPointsPerPolygonLeg = 1 + MinNumDesiredPoints / ControlPolygon.size();
-    Curve.reserve(NumPointsPerPolygonLeg * ControlPolygon.size());
-
-    int z = 0;
-    std::vector<vec3> input = ControlPolygon;
-
-    while (z < 10) {
-
-        for (size_t i(0); i < input.size(); i++) {
-            const vec3& LeftPoint = input[i];
-            const vec3& RightPoint = input[(i + 1) % input.size()];
-
-            // Linearly interpolate between left and right point in the t-interval [0,1)
-            for (size_t j(0); j < NumPointsPerPolygonLeg; j++) {
-                // const float t = float(j) / float(NumPointsPerPolygonLeg); //Gives values from 0
-                // to almost 1
-                float t;
-                t = 0.25;
-                Curve.push_back((1 - t) * LeftPoint + t * RightPoint);
-                t = 0.75;
-                Curve.push_back((1 - t) * LeftPoint + t * RightPoint);
-            }
-        }
-
-        input = Curve;
-
-        z=z+1;
-    }
+    //The scratch level buffer is kept between calls, so repeated subdivisions do not allocate
+    thread_local ChaikinSubdivision Subdivision;
+    Subdivision.Subdivide(ControlPolygon, MinNumDesiredPoints, Curve);
 }
 
 void Chaikin::process()
@@ -90,11 +120,8 @@ void Chaikin::process()
     //Get the input data
     auto MultiInLines = portInLines.getVectorData();
 
-    //Prepare output data
-    auto OutLines = std::make_shared<Mesh>(DrawType::Lines, ConnectivityType::Strip);
-    auto OutVertexBuffer = std::make_shared<Buffer<vec3> >();
-    auto OutVertices = OutVertexBuffer->getEditableRAMRepresentation();
-    OutLines->addBuffer(BufferType::PositionAttrib, OutVertexBuffer);
+    //All polylines of all meshes, as closed control polygons
+    std::vector<std::vector<vec3>> Polylines;
 
     for(auto InLines : MultiInLines)
     {
@@ -113,17 +140,19 @@ void Chaikin::process()
         std::vector<glm::vec3> AllVertices;
         Matrix<4, float> Trafo = InLines->getWorldMatrix();
         const size_t NumInVertices = posRam->getSize();
-        AllVertices.reserve(NumInVertices);
-        for(size_t i(0);i<NumInVertices;i++)
+        AllVertices.resize(NumInVertices);
+        if (auto pTypedRam = dynamic_cast<const BufferRAMPrecision<vec3>*>(posRam))
         {
-            dvec3 Position = posRam->getAsDVec3(i);
-            glm::vec4 HomogeneousPos(Position.x, Position.y, Position.z, 1.0f);
-            glm::vec4 TransformedHomogeneousPos = Trafo * HomogeneousPos;
-
-            AllVertices.push_back( vec3(TransformedHomogeneousPos.x / TransformedHomogeneousPos.w,
-                                        TransformedHomogeneousPos.y / TransformedHomogeneousPos.w,
-                                        TransformedHomogeneousPos.z / TransformedHomogeneousPos.w
-                                        ) );
+            //Float positions are transformed straight from the buffer, in one batch
+            TransformPoints(Trafo, pTypedRam->getDataTyped(), NumInVertices, AllVertices.data());
+        }
+        else
+        {
+            for(size_t i(0);i<NumInVertices;i++)
+            {
+                AllVertices[i] = vec3(posRam->getAsDVec3(i));
+            }
+            TransformPoints(Trafo, AllVertices.data(), NumInVertices, AllVertices.data());
         }
 
         //For each line buffer
@@ -154,30 +183,120 @@ void Chaikin::process()
                 LineVertices.pop_back();
             }
 
-            //Cut the corners!
-            std::vector<vec3> ChaikinVertices;
-            CornerCutting(LineVertices, propMinNumDesiredPoints.get(), ChaikinVertices);
-            const size_t NumNewVertices = ChaikinVertices.size();
-
-            //Write out
-            auto OutIndexBuffer = std::make_shared<IndexBuffer>();
-            auto OutIndices = OutIndexBuffer->getEditableRAMRepresentation();
-            auto OutIndexBufferPoints = std::make_shared<IndexBuffer>();
-            auto OutIndicesPoints = OutIndexBufferPoints->getEditableRAMRepresentation();
-            OutLines->addIndices(Mesh::MeshInfo(DrawType::Lines, ConnectivityType::Strip), OutIndexBuffer);
-            OutLines->addIndices(Mesh::MeshInfo(DrawType::Points, ConnectivityType::None), OutIndexBufferPoints);
-            const size_t PreviousNumVertices = OutVertices->getSize();
-            OutVertices->reserve(NumNewVertices + PreviousNumVertices);
-            for(size_t i(0);i<NumNewVertices;i++)
+            if (!LineVertices.empty()) Polylines.push_back(std::move(LineVertices));
+        }
+    }
+
+    //The adaptive mode decides on the number of points of every segment up front,
+    // with work proportional to the number of control points.
+    const int Mode = propMode.get();
+    const size_t MinNumPoints = propMinNumDesiredPoints.get();
+    const size_t NumPolylines = Polylines.size();
+    std::vector<std::vector<uint32_t>> SegmentCounts(Mode == 2 ? NumPolylines : 0);
+    std::vector<char> Capped(Mode == 2 ? NumPolylines : 0, 0);
+    std::vector<size_t> NumNewVertices(NumPolylines);
+    std::vector<size_t> ControlOffsets(NumPolylines + 1, 0);
+    for(size_t p(0);p<NumPolylines;p++)
+    {
+        ControlOffsets[p + 1] = ControlOffsets[p] + Polylines[p].size();
+    }
+    ForEachWorkRange(ControlOffsets, [&](size_t First, size_t End)
+    {
+        for(size_t p(First);p<End;p++)
+        {
+            const size_t NumControlPoints = Polylines[p].size();
+            switch (Mode)
             {
-                OutVertices->add(ChaikinVertices[i]);
-                OutIndices->add((uint32_t)(PreviousNumVertices + i));
-                OutIndicesPoints->add((uint32_t)(PreviousNumVertices + i));
+                case 1:
+                    NumNewVertices[p] = MinNumPoints;
+                    break;
+
+                case 2:
+                {
+                    bool bCapped;
+                    NumNewVertices[p] = ChaikinSubdivision::AdaptiveSegmentCounts(
+                        Polylines[p], propTolerance.get(), MinNumPoints, SegmentCounts[p], &bCapped);
+                    Capped[p] = bCapped;
+                    break;
+                }
+
+                default:
+                    NumNewVertices[p] = NumControlPoints << ChaikinSubdivision::NumLevels(NumControlPoints, MinNumPoints);
+                    break;
             }
-            OutIndices->add((uint32_t)(PreviousNumVertices)); //Close loop.
         }
+    });
+
+    const size_t NumCapped = std::count(Capped.begin(), Capped.end(), char(1));
+    if (NumCapped > 0)
+    {
+        LogWarn(NumCapped << " polylines bend too sharply for the tolerance; their segments are capped at "
+                << ChaikinSubdivision::MaxPointsPerSegment << " points.");
+    }
+
+    //Where each polyline goes in the output: its vertices, and two indices per vertex
+    // for its segments, the last one closing the loop.
+    std::vector<size_t> VertexOffsets(NumPolylines + 1, 0);
+    for(size_t p(0);p<NumPolylines;p++)
+    {
+        VertexOffsets[p + 1] = VertexOffsets[p] + NumNewVertices[p];
+    }
+    const size_t NumOutVertices = VertexOffsets.back();
+    if (NumOutVertices > size_t(std::numeric_limits<uint32_t>::max()))
+    {
+        LogError("Too many points for 32-bit indices: " << NumOutVertices);
+        return;
     }
 
+    //Cut the corners of all polylines in parallel, straight into the output arrays
+    std::vector<vec3> OutVertices(NumOutVertices);
+    std::vector<uint32_t> OutIndices(2 * NumOutVertices);
+    ForEachWorkRange(VertexOffsets, [&](size_t First, size_t End)
+    {
+        std::vector<vec3> ChaikinVertices;
+        for(size_t p(First);p<End;p++)
+        {
+            switch (Mode)
+            {
+                case 1:
+                    //Exactly the desired number of points on the limit curve
+                    ChaikinSubdivision::EvaluateLimitCurve(Polylines[p], MinNumPoints, ChaikinVertices);
+                    break;
+
+                case 2:
+                    //Points only where the curve bends, within the tolerance
+                    ChaikinSubdivision::EvaluateLimitCurve(Polylines[p], SegmentCounts[p], ChaikinVertices);
+                    break;
+
+                default:
+                    CornerCutting(Polylines[p], MinNumPoints, ChaikinVertices);
+                    break;
+            }
+            std::copy(ChaikinVertices.begin(), ChaikinVertices.end(), OutVertices.begin() + VertexOffsets[p]);
+
+            uint32_t* pIndices = OutIndices.data() + 2 * VertexOffsets[p];
+            const uint32_t FirstVertex = (uint32_t)VertexOffsets[p];
+            const uint32_t NumVertices = (uint32_t)ChaikinVertices.size();
+            for(uint32_t i(0);i<NumVertices;i++)
+            {
+                pIndices[2 * i] = FirstVertex + i;
+                pIndices[2 * i + 1] = FirstVertex + (i + 1) % NumVertices; //Last one closes the loop.
+            }
+        }
+    });
+    std::vector<uint32_t> OutIndicesPoints(NumOutVertices);
+    std::iota(OutIndicesPoints.begin(), OutIndicesPoints.end(), uint32_t(0));
+
+    //One vertex buffer and two index buffers for all polylines.
+    // The lines are separate segments rather than strips, so that all polylines fit into
+    // one buffer and draw without primitive restart.
+    auto OutLines = std::make_shared<Mesh>(DrawType::Lines, ConnectivityType::None);
+    OutLines->addBuffer(BufferType::PositionAttrib, util::makeBuffer(std::move(OutVertices)));
+    OutLines->addIndices(Mesh::MeshInfo(DrawType::Lines, ConnectivityType::None),
+                         util::makeIndexBuffer(std::move(OutIndices)));
+    OutLines->addIndices(Mesh::MeshInfo(DrawType::Points, ConnectivityType::None),
+                         util::makeIndexBuffer(std::move(OutIndicesPoints)));
+
     //Push it out!
     portOutLines.setData(OutLines);
 }
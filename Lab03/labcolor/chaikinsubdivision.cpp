@@ -0,0 +1,208 @@
+/*********************************************************************
+ *  Author  : Tino Weinkauf
+ *  Init    : Sunday, October 18, 2026 - 01:20:44
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#include <modules/labsubdivision/chaikinsubdivision.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <queue>
+
+namespace inviwo
+{
+namespace kth
+{
+
+namespace
+{
+
+/*  One level of corner cutting from the N points at pIn to the 2N points at pOut.
+*/
+void CutCorners(const vec3* pIn, const size_t N, vec3* pOut)
+{
+    for (size_t i(0); i + 1 < N; i++)
+    {
+        pOut[2 * i] = 0.75f * pIn[i] + 0.25f * pIn[i + 1];
+        pOut[2 * i + 1] = 0.25f * pIn[i] + 0.75f * pIn[i + 1];
+    }
+
+    //Closing leg from the last point back to the first
+    pOut[2 * N - 2] = 0.75f * pIn[N - 1] + 0.25f * pIn[0];
+    pOut[2 * N - 1] = 0.25f * pIn[N - 1] + 0.75f * pIn[0];
+}
+
+/*  Point at parameter t in [0, 1] of the limit curve segment of the control points P0, P1, P2,
+    which runs from the midpoint of P0 and P1 to the midpoint of P1 and P2.
+*/
+vec3 LimitPoint(const vec3& P0, const vec3& P1, const vec3& P2, const float t)
+{
+    return 0.5f * (1 - t) * (1 - t) * P0 + (0.5f + t - t * t) * P1 + 0.5f * t * t * P2;
+}
+
+} // namespace
+
+size_t ChaikinSubdivision::NumLevels(const size_t NumControlPoints, const size_t MinNumPoints)
+{
+    if (NumControlPoints == 0) return 0;
+
+    size_t Levels(0);
+    for (size_t NumPoints(NumControlPoints); NumPoints < MinNumPoints; NumPoints *= 2)
+    {
+        Levels++;
+    }
+    return Levels;
+}
+
+void ChaikinSubdivision::Subdivide(const std::vector<vec3>& ControlPolygon,
+                                   const size_t MinNumPoints, std::vector<vec3>& Curve)
+{
+    const size_t NumControlPoints = ControlPolygon.size();
+    const size_t Levels = NumLevels(NumControlPoints, MinNumPoints);
+    if (Levels == 0)
+    {
+        Curve.assign(ControlPolygon.begin(), ControlPolygon.end());
+        return;
+    }
+
+    //Level l goes into Curve if Levels - l is even, so the last one ends up there.
+    //Curve holds the last level, Scratch the one before.
+    Curve.resize(NumControlPoints << Levels);
+    Scratch.resize(NumControlPoints << (Levels - 1));
+
+    const vec3* pIn = ControlPolygon.data();
+    size_t NumPoints = NumControlPoints;
+    for (size_t Level(1); Level <= Levels; Level++)
+    {
+        vec3* pOut = ((Levels - Level) % 2 == 0) ? Curve.data() : Scratch.data();
+        CutCorners(pIn, NumPoints, pOut);
+        pIn = pOut;
+        NumPoints *= 2;
+    }
+}
+
+void ChaikinSubdivision::EvaluateLimitCurve(const std::vector<vec3>& ControlPolygon,
+                                            const size_t NumPoints, std::vector<vec3>& Curve)
+{
+    const size_t NumControlPoints = ControlPolygon.size();
+    Curve.resize(NumControlPoints == 0 ? 0 : NumPoints);
+    if (Curve.empty()) return;
+
+    //Segment i is the quadratic B-spline of P_i, P_i+1, P_i+2, for t in [0, 1)
+    //from the midpoint of leg i to the midpoint of leg i+1.
+    const double SegmentsPerPoint = double(NumControlPoints) / double(NumPoints);
+    for (size_t k(0); k < NumPoints; k++)
+    {
+        const double u = double(k) * SegmentsPerPoint;
+        const size_t Segment = std::min(size_t(u), NumControlPoints - 1);
+        const float t = float(u - double(Segment));
+
+        Curve[k] = LimitPoint(ControlPolygon[Segment],
+                              ControlPolygon[(Segment + 1) % NumControlPoints],
+                              ControlPolygon[(Segment + 2) % NumControlPoints], t);
+    }
+}
+
+void ChaikinSubdivision::Subdivide(const Method SubdivisionMethod,
+                                   const std::vector<vec3>& ControlPolygon,
+                                   const size_t MinNumPoints, const float Tolerance,
+                                   std::vector<vec3>& Curve)
+{
+    switch (SubdivisionMethod)
+    {
+        case Method::LimitCurve:
+            EvaluateLimitCurve(ControlPolygon, MinNumPoints, Curve);
+            break;
+
+        case Method::AdaptiveLimitCurve:
+            AdaptiveSegmentCounts(ControlPolygon, Tolerance, MinNumPoints, SegmentCounts);
+            EvaluateLimitCurve(ControlPolygon, SegmentCounts, Curve);
+            break;
+
+        default:
+            Subdivide(ControlPolygon, MinNumPoints, Curve);
+            break;
+    }
+}
+
+size_t ChaikinSubdivision::AdaptiveSegmentCounts(const std::vector<vec3>& ControlPolygon,
+                                                 const float Tolerance, const size_t MinNumPoints,
+                                                 std::vector<uint32_t>& NumPointsPerSegment,
+                                                 bool* pCapped)
+{
+    const size_t NumControlPoints = ControlPolygon.size();
+    NumPointsPerSegment.resize(NumControlPoints);
+    if (pCapped) *pCapped = false;
+    if (NumControlPoints == 0) return 0;
+
+    //Length of the second difference of every segment, and its share of the points
+    std::vector<float> Bend(NumControlPoints);
+    size_t NumPoints(0);
+    for (size_t i(0); i < NumControlPoints; i++)
+    {
+        const vec3 Difference = ControlPolygon[i] -
+                                2.0f * ControlPolygon[(i + 1) % NumControlPoints] +
+                                ControlPolygon[(i + 2) % NumControlPoints];
+        Bend[i] = glm::length(Difference);
+
+        //Keeps a vanishing tolerance from asking for an unbounded number of points
+        const float k = (Tolerance > 0) ? std::ceil(std::sqrt(Bend[i] / (8 * Tolerance)))
+                                        : (Bend[i] > 0 ? std::numeric_limits<float>::infinity() : 1.0f);
+        if (pCapped && k > float(MaxPointsPerSegment)) *pCapped = true;
+        NumPointsPerSegment[i] = uint32_t(glm::clamp(k, 1.0f, float(MaxPointsPerSegment)));
+        NumPoints += NumPointsPerSegment[i];
+    }
+
+    //Top up to the minimum, always where the deviation Bend / (8 k^2) is largest
+    if (NumPoints < MinNumPoints)
+    {
+        const auto Deviation = [&](size_t i)
+        {
+            const float k = float(NumPointsPerSegment[i]);
+            return Bend[i] / (8 * k * k);
+        };
+        std::priority_queue<std::pair<float, size_t>> Largest;
+        for (size_t i(0); i < NumControlPoints; i++) Largest.emplace(Deviation(i), i);
+
+        for (; NumPoints < MinNumPoints; NumPoints++)
+        {
+            const size_t i = Largest.top().second;
+            Largest.pop();
+            NumPointsPerSegment[i]++;
+            Largest.emplace(Deviation(i), i);
+        }
+    }
+
+    return NumPoints;
+}
+
+void ChaikinSubdivision::EvaluateLimitCurve(const std::vector<vec3>& ControlPolygon,
+                                            const std::vector<uint32_t>& NumPointsPerSegment,
+                                            std::vector<vec3>& Curve)
+{
+    const size_t NumControlPoints = ControlPolygon.size();
+    Curve.resize(std::accumulate(NumPointsPerSegment.begin(), NumPointsPerSegment.end(), size_t(0)));
+
+    vec3* pOut = Curve.data();
+    for (size_t i(0); i < NumControlPoints; i++)
+    {
+        const vec3& P0 = ControlPolygon[i];
+        const vec3& P1 = ControlPolygon[(i + 1) % NumControlPoints];
+        const vec3& P2 = ControlPolygon[(i + 2) % NumControlPoints];
+        const uint32_t NumPoints = NumPointsPerSegment[i];
+        for (uint32_t j(0); j < NumPoints; j++)
+        {
+            *pOut++ = LimitPoint(P0, P1, P2, float(j) / float(NumPoints));
+        }
+    }
+}
+
+} // namespace
+} // namespace
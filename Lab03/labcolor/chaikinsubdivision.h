@@ -0,0 +1,114 @@
+/*********************************************************************
+ *  Author  : Tino Weinkauf
+ *  Init    : Sunday, October 18, 2026 - 01:20:44
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#pragma once
+
+#include <modules/labsubdivision/labsubdivisionmoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <vector>
+
+namespace inviwo
+{
+namespace kth
+{
+
+/** \class ChaikinSubdivision
+    \brief Chaikin's corner cutting of a closed polygon without per-level allocations.
+
+    Every level replaces each leg of the polygon by the points at 1/4 and 3/4 of the
+    leg, which doubles the number of points. Subdivision stops at the first level
+    with at least the desired number of points. Alternatively, the limit curve can be
+    sampled directly, either with any number of points or adaptively to a tolerance.
+
+    The levels are written alternately into the output curve and an internal scratch
+    buffer, starting with the one that makes the last level land in the output. Both
+    are sized once from the number of levels; when an instance is reused, they keep
+    their capacity and no memory is allocated at all.
+
+    @author Tino Weinkauf
+*/
+class IVW_MODULE_LABSUBDIVISION_API ChaikinSubdivision
+{
+//Types
+public:
+    ///Same order as the mode options of the Chaikin processor
+    enum class Method
+    {
+        CornerCutting,
+        LimitCurve,
+        AdaptiveLimitCurve
+    };
+
+    ///Most points that AdaptiveSegmentCounts gives a segment for the tolerance
+    static constexpr uint32_t MaxPointsPerSegment = 1 << 12;
+
+//Methods
+public:
+    ///Number of levels for a polygon with NumControlPoints points to reach MinNumPoints
+    static size_t NumLevels(size_t NumControlPoints, size_t MinNumPoints);
+
+    /** Subdivides the closed ControlPolygon until it has at least MinNumPoints points.
+        The first point is not repeated at the end of Curve.
+    */
+    void Subdivide(const std::vector<vec3>& ControlPolygon, size_t MinNumPoints,
+                   std::vector<vec3>& Curve);
+
+    /** Samples the limit curve of corner cutting, the closed uniform quadratic B-spline
+        of ControlPolygon, with exactly NumPoints points evenly spaced in its parameter.
+
+        The curve runs through the midpoints of the legs, starting at the midpoint of
+        the first leg. Every point is evaluated directly from three control points.
+    */
+    static void EvaluateLimitCurve(const std::vector<vec3>& ControlPolygon, size_t NumPoints,
+                                   std::vector<vec3>& Curve);
+
+    /** Number of points per segment of the limit curve such that the polyline through
+        them deviates from the curve by at most Tolerance, with at least MinNumPoints
+        points in total. Returns the total number of points.
+
+        Segment i is a quadratic curve whose chords of parameter length 1/k deviate by
+        at most |P_i - 2 P_i+1 + P_i+2| / (8 k^2), so straight stretches get a single
+        point and sharp corners many. Missing points up to MinNumPoints go one by one to
+        the segment with the largest remaining deviation.
+
+        A segment gets at most MaxPointsPerSegment points for the tolerance, so that a
+        vanishing tolerance cannot ask for an unbounded number of points. The tolerance is
+        then not met: it holds only if every |P_i - 2 P_i+1 + P_i+2| is at most
+        8 MaxPointsPerSegment^2 Tolerance. A non-positive Tolerance caps every segment that
+        bends at all. If pCapped is given, it tells whether any segment was capped.
+    */
+    static size_t AdaptiveSegmentCounts(const std::vector<vec3>& ControlPolygon,
+                                        float Tolerance, size_t MinNumPoints,
+                                        std::vector<uint32_t>& NumPointsPerSegment,
+                                        bool* pCapped = nullptr);
+
+    /** Samples the limit curve with NumPointsPerSegment[i] points evenly spaced in the
+        parameter of segment i, from the midpoint of leg i towards the midpoint of leg i+1.
+    */
+    static void EvaluateLimitCurve(const std::vector<vec3>& ControlPolygon,
+                                   const std::vector<uint32_t>& NumPointsPerSegment,
+                                   std::vector<vec3>& Curve);
+
+    /** Subdivides ControlPolygon with the given method. MinNumPoints is the minimum number
+        of points for corner cutting and the adaptive limit curve, and the exact number for
+        the limit curve. Tolerance is only used by the adaptive limit curve.
+    */
+    void Subdivide(Method SubdivisionMethod, const std::vector<vec3>& ControlPolygon,
+                   size_t MinNumPoints, float Tolerance, std::vector<vec3>& Curve);
+
+//Attributes
+private:
+    std::vector<vec3> Scratch;
+    std::vector<uint32_t> SegmentCounts;
+};
+
+} // namespace
+} // namespace
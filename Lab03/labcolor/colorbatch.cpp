@@ -0,0 +1,343 @@
+/*********************************************************************
+ *  Author  : Tino Weinkauf
+ *  Init    : Saturday, October 17, 2026 - 21:52:06
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#include <modules/labcolor/colorbatch.h>
+#include <modules/labcolor/cpufeatures.h>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(LABCOLOR_X86)
+#include <immintrin.h>
+#endif
+
+namespace inviwo
+{
+namespace kth
+{
+namespace ColorBatch
+{
+
+namespace
+{
+
+// Single-color versions, used for the tail of a batch and on CPUs without AVX2.
+
+void RgbToHsv1(float R, float G, float B, float& H, float& S, float& V)
+{
+    const float r = R / 255.0f, g = G / 255.0f, b = B / 255.0f;
+    const float Max = std::max(r, std::max(g, b));
+    const float Min = std::min(r, std::min(g, b));
+    const float Delta = Max - Min;
+
+    V = Max;
+    S = (Max > 1e-3f) ? Delta / Max : 0.0f;
+    if (Delta == 0)
+    {
+        H = 0;
+        return;
+    }
+
+    if (r == Max) H = (g - b) / Delta;
+    else if (g == Max) H = 2 + (b - r) / Delta;
+    else H = 4 + (r - g) / Delta;
+    H = std::fmod(H * 60 + 360, 360.0f);
+}
+
+void HsvToRgb1(float H, float S, float V, float& R, float& G, float& B)
+{
+    const float Sector = H / 60;
+    const float C = V * S;
+    const float X = C * (1 - std::abs(std::fmod(Sector, 2.0f) - 1));
+    const float M = V - C;
+    const float CM = (C + M) * 255, XM = (X + M) * 255, M255 = M * 255;
+
+    switch (static_cast<int>(std::floor(Sector)))
+    {
+        case 0: R = CM; G = XM; B = M255; break;
+        case 1: R = XM; G = CM; B = M255; break;
+        case 2: R = M255; G = CM; B = XM; break;
+        case 3: R = M255; G = XM; B = CM; break;
+        case 4: R = XM; G = M255; B = CM; break;
+        default: R = CM; G = M255; B = XM; break;
+    }
+}
+
+void RgbToCmyk1(float R, float G, float B, float& C, float& M, float& Y, float& K)
+{
+    const float c = 1 - R / 255.0f, m = 1 - G / 255.0f, y = 1 - B / 255.0f;
+    K = std::min(1.0f, std::min(c, std::min(m, y)));
+    if (std::abs(K - 1) < 1e-3f)
+    {
+        C = M = Y = 0;
+        return;
+    }
+    C = (c - K) / (1 - K);
+    M = (m - K) / (1 - K);
+    Y = (y - K) / (1 - K);
+}
+
+void CmykToRgb1(float C, float M, float Y, float K, float& R, float& G, float& B)
+{
+    R = (1 - (C * (1 - K) + K)) * 255;
+    G = (1 - (M * (1 - K) + K)) * 255;
+    B = (1 - (Y * (1 - K) + K)) * 255;
+}
+
+// CIE constants as used by the ColorSpace library
+constexpr float WhiteX = 95.047f, WhiteY = 100.000f, WhiteZ = 108.883f;
+constexpr float LabEpsilon = 216.0f / 24389.0f;
+constexpr float LabKappa = 24389.0f / 27.0f;
+
+float ToLinear(float Component)
+{
+    const float c = Component / 255.0f;
+    return ((c > 0.04045f) ? std::pow((c + 0.055f) / 1.055f, 2.4f) : (c / 12.92f)) * 100.0f;
+}
+
+float FromLinear(float Component)
+{
+    return ((Component > 0.0031308f) ? (1.055f * std::pow(Component, 1 / 2.4f) - 0.055f)
+                                     : (12.92f * Component)) * 255.0f;
+}
+
+float LabF(float t)
+{
+    return (t > LabEpsilon) ? std::cbrt(t) : (LabKappa * t + 16.0f) / 116.0f;
+}
+
+#if defined(LABCOLOR_X86)
+
+LABCOLOR_TARGET_AVX2
+inline __m256 Select(__m256 Mask, __m256 IfTrue, __m256 IfFalse)
+{
+    return _mm256_blendv_ps(IfFalse, IfTrue, Mask);
+}
+
+/// x - y * trunc(x / y), which is fmod for the value ranges used here
+LABCOLOR_TARGET_AVX2
+inline __m256 Mod(__m256 x, __m256 y)
+{
+    const __m256 Quotient = _mm256_round_ps(_mm256_div_ps(x, y), _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    return _mm256_sub_ps(x, _mm256_mul_ps(y, Quotient));
+}
+
+/// (1 - (Component * (1 - k) + k)) * 255
+LABCOLOR_TARGET_AVX2
+inline __m256 CmykComponentToRgb(__m256 Component, __m256 k)
+{
+    const __m256 One = _mm256_set1_ps(1.0f);
+    const __m256 Ink = _mm256_add_ps(_mm256_mul_ps(Component, _mm256_sub_ps(One, k)), k);
+    return _mm256_mul_ps(_mm256_sub_ps(One, Ink), _mm256_set1_ps(255.0f));
+}
+
+// Eight colors per instruction, each returns how many colors it converted
+
+LABCOLOR_TARGET_AVX2
+size_t RgbToHsv8(size_t N, const float* R, const float* G, const float* B, float* H, float* S,
+                 float* V)
+{
+    size_t i(0);
+    const __m256 Zero = _mm256_setzero_ps();
+    const __m256 Scale = _mm256_set1_ps(255.0f);
+    for (; i + 8 <= N; i += 8)
+    {
+        const __m256 r = _mm256_div_ps(_mm256_loadu_ps(R + i), Scale);
+        const __m256 g = _mm256_div_ps(_mm256_loadu_ps(G + i), Scale);
+        const __m256 b = _mm256_div_ps(_mm256_loadu_ps(B + i), Scale);
+        const __m256 Max = _mm256_max_ps(r, _mm256_max_ps(g, b));
+        const __m256 Min = _mm256_min_ps(r, _mm256_min_ps(g, b));
+        const __m256 Delta = _mm256_sub_ps(Max, Min);
+
+        const __m256 Saturated = _mm256_cmp_ps(Max, _mm256_set1_ps(1e-3f), _CMP_GT_OQ);
+        const __m256 s = Select(Saturated, _mm256_div_ps(Delta, Max), Zero);
+
+        // Lanes with Delta = 0 divide by zero here and are replaced by hue 0 below
+        __m256 h = _mm256_add_ps(_mm256_set1_ps(4), _mm256_div_ps(_mm256_sub_ps(r, g), Delta));
+        h = Select(_mm256_cmp_ps(g, Max, _CMP_EQ_OQ),
+                   _mm256_add_ps(_mm256_set1_ps(2), _mm256_div_ps(_mm256_sub_ps(b, r), Delta)), h);
+        h = Select(_mm256_cmp_ps(r, Max, _CMP_EQ_OQ), _mm256_div_ps(_mm256_sub_ps(g, b), Delta), h);
+        h = _mm256_add_ps(_mm256_mul_ps(h, _mm256_set1_ps(60)), _mm256_set1_ps(360));
+        h = Mod(h, _mm256_set1_ps(360));
+        h = Select(_mm256_cmp_ps(Delta, Zero, _CMP_EQ_OQ), Zero, h);
+
+        _mm256_storeu_ps(H + i, h);
+        _mm256_storeu_ps(S + i, s);
+        _mm256_storeu_ps(V + i, Max);
+    }
+    return i;
+}
+
+LABCOLOR_TARGET_AVX2
+size_t HsvToRgb8(size_t N, const float* H, const float* S, const float* V, float* R, float* G,
+                 float* B)
+{
+    size_t i(0);
+    const __m256 One = _mm256_set1_ps(1.0f);
+    const __m256 Two = _mm256_set1_ps(2.0f);
+    const __m256 Scale = _mm256_set1_ps(255.0f);
+    const __m256 SignMask = _mm256_set1_ps(-0.0f);
+    for (; i + 8 <= N; i += 8)
+    {
+        const __m256 v = _mm256_loadu_ps(V + i);
+        const __m256 Sector = _mm256_div_ps(_mm256_loadu_ps(H + i), _mm256_set1_ps(60));
+        const __m256 C = _mm256_mul_ps(v, _mm256_loadu_ps(S + i));
+        const __m256 Ramp = _mm256_andnot_ps(SignMask, _mm256_sub_ps(Mod(Sector, Two), One));
+        const __m256 X = _mm256_mul_ps(C, _mm256_sub_ps(One, Ramp));
+        const __m256 M = _mm256_sub_ps(v, C);
+        const __m256 CM = _mm256_mul_ps(_mm256_add_ps(C, M), Scale);
+        const __m256 XM = _mm256_mul_ps(_mm256_add_ps(X, M), Scale);
+        const __m256 M255 = _mm256_mul_ps(M, Scale);
+
+        // Start with the last sector, which also catches hues outside [0, 360)
+        const __m256 Range = _mm256_floor_ps(Sector);
+        __m256 r = CM, g = M255, b = XM;
+        const __m256 Cases[5][3] = {
+            {CM, XM, M255}, {XM, CM, M255}, {M255, CM, XM}, {M255, XM, CM}, {XM, M255, CM}};
+        for (int Case(0); Case < 5; Case++)
+        {
+            const __m256 InCase = _mm256_cmp_ps(Range, _mm256_set1_ps(float(Case)), _CMP_EQ_OQ);
+            r = Select(InCase, Cases[Case][0], r);
+            g = Select(InCase, Cases[Case][1], g);
+            b = Select(InCase, Cases[Case][2], b);
+        }
+
+        _mm256_storeu_ps(R + i, r);
+        _mm256_storeu_ps(G + i, g);
+        _mm256_storeu_ps(B + i, b);
+    }
+    return i;
+}
+
+LABCOLOR_TARGET_AVX2
+size_t RgbToCmyk8(size_t N, const float* R, const float* G, const float* B, float* C, float* M,
+                  float* Y, float* K)
+{
+    size_t i(0);
+    const __m256 Zero = _mm256_setzero_ps();
+    const __m256 One = _mm256_set1_ps(1.0f);
+    const __m256 Scale = _mm256_set1_ps(255.0f);
+    const __m256 SignMask = _mm256_set1_ps(-0.0f);
+    for (; i + 8 <= N; i += 8)
+    {
+        const __m256 c = _mm256_sub_ps(One, _mm256_div_ps(_mm256_loadu_ps(R + i), Scale));
+        const __m256 m = _mm256_sub_ps(One, _mm256_div_ps(_mm256_loadu_ps(G + i), Scale));
+        const __m256 y = _mm256_sub_ps(One, _mm256_div_ps(_mm256_loadu_ps(B + i), Scale));
+        const __m256 k = _mm256_min_ps(One, _mm256_min_ps(c, _mm256_min_ps(m, y)));
+
+        // Pure black has no defined chromatic components
+        const __m256 Black = _mm256_cmp_ps(_mm256_andnot_ps(SignMask, _mm256_sub_ps(k, One)),
+                                           _mm256_set1_ps(1e-3f), _CMP_LT_OQ);
+        const __m256 White = _mm256_sub_ps(One, k);
+        _mm256_storeu_ps(C + i, Select(Black, Zero, _mm256_div_ps(_mm256_sub_ps(c, k), White)));
+        _mm256_storeu_ps(M + i, Select(Black, Zero, _mm256_div_ps(_mm256_sub_ps(m, k), White)));
+        _mm256_storeu_ps(Y + i, Select(Black, Zero, _mm256_div_ps(_mm256_sub_ps(y, k), White)));
+        _mm256_storeu_ps(K + i, k);
+    }
+    return i;
+}
+
+LABCOLOR_TARGET_AVX2
+size_t CmykToRgb8(size_t N, const float* C, const float* M, const float* Y, const float* K,
+                  float* R, float* G, float* B)
+{
+    size_t i(0);
+    for (; i + 8 <= N; i += 8)
+    {
+        const __m256 k = _mm256_loadu_ps(K + i);
+        _mm256_storeu_ps(R + i, CmykComponentToRgb(_mm256_loadu_ps(C + i), k));
+        _mm256_storeu_ps(G + i, CmykComponentToRgb(_mm256_loadu_ps(M + i), k));
+        _mm256_storeu_ps(B + i, CmykComponentToRgb(_mm256_loadu_ps(Y + i), k));
+    }
+    return i;
+}
+
+#endif
+
+} // namespace
+
+void RgbToHsv(size_t N, const float* R, const float* G, const float* B, float* H, float* S,
+              float* V)
+{
+    size_t i(0);
+#if defined(LABCOLOR_X86)
+    if (CpuFeatures::Current() >= CpuFeatures::SimdLevel::AVX2) i = RgbToHsv8(N, R, G, B, H, S, V);
+#endif
+    for (; i < N; i++) RgbToHsv1(R[i], G[i], B[i], H[i], S[i], V[i]);
+}
+
+void HsvToRgb(size_t N, const float* H, const float* S, const float* V, float* R, float* G,
+              float* B)
+{
+    size_t i(0);
+#if defined(LABCOLOR_X86)
+    if (CpuFeatures::Current() >= CpuFeatures::SimdLevel::AVX2) i = HsvToRgb8(N, H, S, V, R, G, B);
+#endif
+    for (; i < N; i++) HsvToRgb1(H[i], S[i], V[i], R[i], G[i], B[i]);
+}
+
+void RgbToCmyk(size_t N, const float* R, const float* G, const float* B, float* C, float* M,
+               float* Y, float* K)
+{
+    size_t i(0);
+#if defined(LABCOLOR_X86)
+    if (CpuFeatures::Current() >= CpuFeatures::SimdLevel::AVX2) i = RgbToCmyk8(N, R, G, B, C, M, Y, K);
+#endif
+    for (; i < N; i++) RgbToCmyk1(R[i], G[i], B[i], C[i], M[i], Y[i], K[i]);
+}
+
+void CmykToRgb(size_t N, const float* C, const float* M, const float* Y, const float* K, float* R,
+               float* G, float* B)
+{
+    size_t i(0);
+#if defined(LABCOLOR_X86)
+    if (CpuFeatures::Current() >= CpuFeatures::SimdLevel::AVX2) i = CmykToRgb8(N, C, M, Y, K, R, G, B);
+#endif
+    for (; i < N; i++) CmykToRgb1(C[i], M[i], Y[i], K[i], R[i], G[i], B[i]);
+}
+
+void RgbToLab(size_t N, const float* R, const float* G, const float* B, float* L, float* A,
+              float* LabB)
+{
+    for (size_t i(0); i < N; i++)
+    {
+        const float r = ToLinear(R[i]), g = ToLinear(G[i]), b = ToLinear(B[i]);
+        const float x = LabF((r * 0.4124564f + g * 0.3575761f + b * 0.1804375f) / WhiteX);
+        const float y = LabF((r * 0.2126729f + g * 0.7151522f + b * 0.0721750f) / WhiteY);
+        const float z = LabF((r * 0.0193339f + g * 0.1191920f + b * 0.9503041f) / WhiteZ);
+        L[i] = std::max(0.0f, 116.0f * y - 16.0f);
+        A[i] = 500.0f * (x - y);
+        LabB[i] = 200.0f * (y - z);
+    }
+}
+
+void LabToRgb(size_t N, const float* L, const float* A, const float* LabB, float* R, float* G,
+              float* B)
+{
+    for (size_t i(0); i < N; i++)
+    {
+        const float y = (L[i] + 16.0f) / 116.0f;
+        const float x = A[i] / 500.0f + y;
+        const float z = y - LabB[i] / 200.0f;
+        const float x3 = x * x * x, y3 = y * y * y, z3 = z * z * z;
+
+        const float X = WhiteX * ((x3 > LabEpsilon) ? x3 : (x - 16.0f / 116.0f) / 7.787f) / 100;
+        const float Y = WhiteY * ((L[i] > LabKappa * LabEpsilon) ? y3 : L[i] / LabKappa) / 100;
+        const float Z = WhiteZ * ((z3 > LabEpsilon) ? z3 : (z - 16.0f / 116.0f) / 7.787f) / 100;
+
+        R[i] = FromLinear(X * 3.2404542f + Y * -1.5371385f + Z * -0.4985314f);
+        G[i] = FromLinear(X * -0.9692660f + Y * 1.8760108f + Z * 0.0415560f);
+        B[i] = FromLinear(X * 0.0556434f + Y * -0.2040259f + Z * 1.0572252f);
+    }
+}
+
+} // namespace ColorBatch
+} // namespace
+} // namespace
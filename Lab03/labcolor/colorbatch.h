@@ -0,0 +1,63 @@
+/*********************************************************************
+ *  Author  : Tino Weinkauf
+ *  Init    : Saturday, October 17, 2026 - 21:52:06
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#pragma once
+
+#include <modules/labcolor/labcolormoduledefine.h>
+
+#include <cstddef>
+
+namespace inviwo
+{
+namespace kth
+{
+
+/*  Batch color conversions on structure-of-arrays data.
+
+    Every function converts N colors at once, reading and writing one contiguous float
+    array per component. Input and output arrays must not overlap. The encodings and
+    formulas are those of the ColorSpace library, so the results agree with converting
+    the colors one by one through ColorSpace::Rgb::To<...>() and ToRgb(), up to float
+    precision:
+
+      RGB   r, g, b in [0, 255]
+      HSV   h in [0, 360], s and v in [0, 1]
+      CMYK  c, m, y, k in [0, 1]
+      Lab   CIE L*a*b* for the D65 white point, L in [0, 100]
+
+    RGB <-> HSV and RGB <-> CMYK run eight colors per AVX2 instruction on CPUs that have
+    it, see CpuFeatures::Current(). The Lab conversions need pow and cbrt per component
+    and are plain loops the compiler can vectorize if it has a vector math library.
+*/
+namespace ColorBatch
+{
+
+IVW_MODULE_LABCOLOR_API void RgbToHsv(size_t N, const float* R, const float* G, const float* B,
+                                      float* H, float* S, float* V);
+
+IVW_MODULE_LABCOLOR_API void HsvToRgb(size_t N, const float* H, const float* S, const float* V,
+                                      float* R, float* G, float* B);
+
+IVW_MODULE_LABCOLOR_API void RgbToCmyk(size_t N, const float* R, const float* G, const float* B,
+                                       float* C, float* M, float* Y, float* K);
+
+IVW_MODULE_LABCOLOR_API void CmykToRgb(size_t N, const float* C, const float* M, const float* Y,
+                                       const float* K, float* R, float* G, float* B);
+
+IVW_MODULE_LABCOLOR_API void RgbToLab(size_t N, const float* R, const float* G, const float* B,
+                                      float* L, float* A, float* LabB);
+
+IVW_MODULE_LABCOLOR_API void LabToRgb(size_t N, const float* L, const float* A, const float* LabB,
+                                      float* R, float* G, float* B);
+
+} // namespace ColorBatch
+
+} // namespace
+} // namespace
@@ -9,10 +9,21 @@
  */
 
 #include <modules/labcolor/colorinterpolation.h>
+#include <modules/labcolor/colorbatch.h>
+#include <modules/labcolor/deltae2000.h>
+#include <modules/labcolor/parallelrows.h>
+#include <modules/labcolor/swatchlut.h>
+#include <modules/labcolor/templatemask.h>
+#include <modules/labcolor/templaterecolor.h>
 
 #include <modules/labcolor/colorspace/src/ColorSpace.h>
 #include <modules/labcolor/colorspace/src/Comparison.h>
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vector>
+
 namespace {
 /*  Interpolates between two colors in RGB color space.
 
@@ -172,29 +183,155 @@ glm::u8vec3 ToOutputColor(ColorSpace::IColorSpace& Color) {
     Color.ToRgb(&RGB);
     return glm::u8vec3(RGB.r, RGB.g, RGB.b);
 }
+
+/*  Everything the swatch kernels need that depends only on the two primary colors.
+    It is filled once per frame instead of once per pixel.
+*/
+struct SwatchColors {
+    ColorSpace::Rgb rgbColorA, rgbColorB;
+    ColorSpace::Cmyk cmykColorA, cmykColorB;
+    ColorSpace::Hsv hsvColorA, hsvColorB;
+    glm::u8vec3 OutputA, OutputB;
+    // Black or White, whichever is further from the respective primary color
+    glm::u8vec3 ContrastA, ContrastB;
+};
+
+glm::u8vec3 ContrastColor(const ColorSpace::Hsv& Color) {
+    float h(float(Color.h)), s(float(Color.s)), v(float(Color.v));
+    float r, g, b, L, A, B;
+    ColorBatch::HsvToRgb(1, &h, &s, &v, &r, &g, &b);
+    ColorBatch::RgbToLab(1, &r, &g, &b, &L, &A, &B);
+    unsigned char IsCloserToWhite;
+    ColorBatch::FartherFromFirst(1, &L, &A, &B, ColorBatch::LabReference::Black(),
+                                 ColorBatch::LabReference::White(), &IsCloserToWhite);
+    return IsCloserToWhite ? glm::u8vec3(0) : glm::u8vec3(255);
+}
+
+/*  Scratch rows of one thread for converting a row of swatch colors in one batch.
+*/
+struct SwatchRow {
+    std::vector<float> C0, C1, C2, C3, R, G, B;
+    std::vector<unsigned char> UseContrast;
+
+    static SwatchRow& Get(size_t N) {
+        thread_local SwatchRow Row;
+        for (auto* pComponent : {&Row.C0, &Row.C1, &Row.C2, &Row.C3, &Row.R, &Row.G, &Row.B}) {
+            if (pComponent->size() < N) pComponent->resize(N);
+        }
+        if (Row.UseContrast.size() < N) Row.UseContrast.resize(N);
+        return Row;
+    }
+
+    void Store(size_t k, const ColorSpace::Hsv& Color) {
+        C0[k] = float(Color.h);
+        C1[k] = float(Color.s);
+        C2[k] = float(Color.v);
+    }
+
+    void WriteRgb(size_t N, glm::u8vec3* pOut) const {
+        for (size_t k(0); k < N; k++) pOut[k] = glm::u8vec3(R[k], G[k], B[k]);
+    }
+};
+
+/*  Swatch kernels color N pixels with interpolation parameters t[0..N).
+*/
+using SwatchKernel = void (*)(const SwatchColors& Colors, const vec2* t, size_t N,
+                              glm::u8vec3* pOut);
+
+void SwatchRGB(const SwatchColors& Colors, const vec2* t, size_t N, glm::u8vec3* pOut) {
+    for (size_t k(0); k < N; k++) {
+        ColorSpace::Rgb rgbInterpol = InterpolateInRGB(Colors.rgbColorA, Colors.rgbColorB, t[k].x);
+        pOut[k] = glm::u8vec3(rgbInterpol.r, rgbInterpol.g, rgbInterpol.b);
+    }
+}
+
+void SwatchCMYK(const SwatchColors& Colors, const vec2* t, size_t N, glm::u8vec3* pOut) {
+    SwatchRow& Row = SwatchRow::Get(N);
+    for (size_t k(0); k < N; k++) {
+        ColorSpace::Cmyk cmykInterpol =
+            InterpolateInCMYK(Colors.cmykColorA, Colors.cmykColorB, t[k].x);
+        Row.C0[k] = float(cmykInterpol.c);
+        Row.C1[k] = float(cmykInterpol.m);
+        Row.C2[k] = float(cmykInterpol.y);
+        Row.C3[k] = float(cmykInterpol.k);
+    }
+    ColorBatch::CmykToRgb(N, Row.C0.data(), Row.C1.data(), Row.C2.data(), Row.C3.data(),
+                          Row.R.data(), Row.G.data(), Row.B.data());
+    Row.WriteRgb(N, pOut);
+}
+
+void SwatchHSV(const SwatchColors& Colors, const vec2* t, size_t N, glm::u8vec3* pOut) {
+    SwatchRow& Row = SwatchRow::Get(N);
+    for (size_t k(0); k < N; k++) {
+        Row.Store(k, InterpolateInHSV(Colors.hsvColorA, Colors.hsvColorB, t[k].x));
+    }
+    ColorBatch::HsvToRgb(N, Row.C0.data(), Row.C1.data(), Row.C2.data(), Row.R.data(),
+                         Row.G.data(), Row.B.data());
+    Row.WriteRgb(N, pOut);
+}
+
+void SwatchValueSaturation(const SwatchColors& Colors, const vec2* t, size_t N,
+                           glm::u8vec3* pOut) {
+    SwatchRow& Row = SwatchRow::Get(N);
+    for (size_t k(0); k < N; k++) {
+        ColorSpace::Hsv hsvInterpol = ChangeValueAndSaturation(Colors.hsvColorA, t[k].x, t[k].y);
+        Row.Store(k, hsvInterpol);
+        Row.UseContrast[k] = !(pow(Colors.hsvColorA.v - hsvInterpol.v, 2) +
+                                   pow(Colors.hsvColorA.s - hsvInterpol.s, 2) >
+                               0.0025);
+    }
+    ColorBatch::HsvToRgb(N, Row.C0.data(), Row.C1.data(), Row.C2.data(), Row.R.data(),
+                         Row.G.data(), Row.B.data());
+    Row.WriteRgb(N, pOut);
+    for (size_t k(0); k < N; k++) {
+        if (Row.UseContrast[k]) pOut[k] = Colors.ContrastA;
+    }
+}
+
+void SwatchHueSaturation(const SwatchColors& Colors, const vec2* t, size_t N, glm::u8vec3* pOut) {
+    SwatchRow& Row = SwatchRow::Get(N);
+    for (size_t k(0); k < N; k++) {
+        ColorSpace::Hsv hsvInterpol =
+            ChangeHueAndSaturation(Colors.hsvColorB, 1.0f - t[k].x, t[k].y);
+        Row.Store(k, hsvInterpol);
+        Row.UseContrast[k] = !(pow(Colors.hsvColorB.h / 360 - hsvInterpol.h / 360, 2) +
+                                   pow(Colors.hsvColorB.s - hsvInterpol.s, 2) >
+                               0.0025);
+    }
+    ColorBatch::HsvToRgb(N, Row.C0.data(), Row.C1.data(), Row.C2.data(), Row.R.data(),
+                         Row.G.data(), Row.B.data());
+    Row.WriteRgb(N, pOut);
+    for (size_t k(0); k < N; k++) {
+        if (Row.UseContrast[k]) pOut[k] = Colors.ContrastB;
+    }
+}
+
+/*  One entry per marker value of the red channel. Markers without a kernel are left alone.
+*/
+struct SwatchDispatch {
+    SwatchKernel Kernel = nullptr;
+    const SwatchLUT* LUT = nullptr;
+    size2_t BBoxMin{0};
+    vec2 BBoxExtent{0};
+};
 }  // namespace
 
 void ColorInterpolation::Mix(const size2_t& Resolution, glm::u8vec3* pRaw) {
     // Find color template spaces
     if (portInImage.isChanged()) {
+        // One scan over the image; afterwards only the template spans are visited
+        Template.Scan(Resolution, pRaw);
         ColorTemplateBBoxes.clear();
-        for (size_t j(0), Idx(0); j < Resolution.y; j++) {
-            for (size_t i(0); i < Resolution.x; i++, Idx++) {
-                if (pRaw[Idx].r > 110 && pRaw[Idx].g == 0 && pRaw[Idx].b == 0) {
-                    auto itTemplateBBox = ColorTemplateBBoxes.find(pRaw[Idx].r);
-                    if (itTemplateBBox != ColorTemplateBBoxes.end()) {
-                        auto& BBox = itTemplateBBox->second;
-                        // Existing color template found; expand the bbox.
-                        BBox.first.x = std::min(BBox.first.x, (size_t)i);
-                        BBox.first.y = std::min(BBox.first.y, (size_t)j);
-                        BBox.second.x = std::max(BBox.second.x, (size_t)i);
-                        BBox.second.y = std::max(BBox.second.y, (size_t)j);
-                    } else {
-                        // New color template found; init the bbox.
-                        ColorTemplateBBoxes[pRaw[Idx].r] =
-                            std::make_pair(size2_t(i, j), size2_t(i, j));
-                    }
-                }
+        for (const unsigned char Marker : Template.GetMarkers()) {
+            ColorTemplateBBoxes[Marker] = Template.GetBBox(Marker);
+        }
+
+        // Drop the tables of swatches that are no longer part of the template
+        for (auto itLUT = SwatchLUTs.begin(); itLUT != SwatchLUTs.end();) {
+            if (ColorTemplateBBoxes.count(itLUT->first)) {
+                ++itLUT;
+            } else {
+                itLUT = SwatchLUTs.erase(itLUT);
             }
         }
 
@@ -208,100 +345,84 @@ void ColorInterpolation::Mix(const size2_t& Resolution, glm::u8vec3* pRaw) {
     const vec3 ColorA(propColorA.get().r, propColorA.get().g, propColorA.get().b);
     const vec3 ColorB(propColorB.get().r, propColorB.get().g, propColorB.get().b);
 
-    // Some helper colors
-    ColorSpace::Hsv Black(0, 0, 0), White(0, 0, 1);
-
-    for (size_t j(0), Idx(0); j < Resolution.y; j++) {
-        for (size_t i(0); i < Resolution.x; i++, Idx++) {
-            if (pRaw[Idx].r > 110 && pRaw[Idx].g == 0 && pRaw[Idx].b == 0) {
-                if (pRaw[Idx].r > 210) {
-                    // Primary color swatches
-                    pRaw[Idx] = (pRaw[Idx].r == 255) ? ToUChar(ColorA) : ToUChar(ColorB);
-                } else {
-                    // Primary colors in RGB
-                    ColorSpace::Rgb rgbColorA(ColorA.r * 255.0, ColorA.g * 255.0, ColorA.b * 255.0);
-                    ColorSpace::Rgb rgbColorB(ColorB.r * 255.0, ColorB.g * 255.0, ColorB.b * 255.0);
-
-                    // Interpolation boxes
-                    // - get the bbox
-                    auto itTemplateBBox = ColorTemplateBBoxes.find(pRaw[Idx].r);
-                    ivwAssert(itTemplateBBox != ColorTemplateBBoxes.end(), "Check this.");
-                    size2_t& BBoxMin = itTemplateBBox->second.first;
-                    size2_t& BBoxMax = itTemplateBBox->second.second;
-                    // - get the interpolation values in x-direction and y-direction.
-                    // -  - they run in the interval [0, 1].
-                    vec2 t = vec2(size2_t(i, j) - BBoxMin) / vec2(BBoxMax - BBoxMin);
-
-                    switch (pRaw[Idx].r) {
-                        case 200: {
-                            ColorSpace::Rgb rgbInterpol =
-                                InterpolateInRGB(rgbColorA, rgbColorB, t.x);
-                            pRaw[Idx] = ToOutputColor(rgbInterpol);
-                            break;
-                        }
-
-                        case 180: {
-                            ColorSpace::Cmyk cmykColorA, cmykColorB;
-                            rgbColorA.To<ColorSpace::Cmyk>(&cmykColorA);
-                            rgbColorB.To<ColorSpace::Cmyk>(&cmykColorB);
-                            ColorSpace::Cmyk cmykInterpol =
-                                InterpolateInCMYK(cmykColorA, cmykColorB, t.x);
-                            pRaw[Idx] = ToOutputColor(cmykInterpol);
-                            break;
-                        }
-
-                        case 160: {
-                            ColorSpace::Hsv hsvColorA, hsvColorB;
-                            rgbColorA.To<ColorSpace::Hsv>(&hsvColorA);
-                            rgbColorB.To<ColorSpace::Hsv>(&hsvColorB);
-                            ColorSpace::Hsv hsvInterpol =
-                                InterpolateInHSV(hsvColorA, hsvColorB, t.x);
-                            pRaw[Idx] = ToOutputColor(hsvInterpol);
-                            break;
-                        }
-
-                        case 140: {
-                            ColorSpace::Hsv hsvColorA;
-                            rgbColorA.To<ColorSpace::Hsv>(&hsvColorA);
-                            ColorSpace::Hsv hsvInterpol =
-                                ChangeValueAndSaturation(hsvColorA, t.x, t.y);
-                            if (pow(hsvColorA.v - hsvInterpol.v, 2) +
-                                    pow(hsvColorA.s - hsvInterpol.s, 2) >
-                                0.0025) {
-                                pRaw[Idx] = ToOutputColor(hsvInterpol);
-                            } else {
-                                const double DistanceToBlackWhite =
-                                    ColorSpace::Cie2000Comparison::Compare(&hsvColorA, &Black) -
-                                    ColorSpace::Cie2000Comparison::Compare(&hsvColorA, &White);
-                                pRaw[Idx] = (DistanceToBlackWhite > 0) ? ToOutputColor(Black)
-                                                                       : ToOutputColor(White);
-                            }
-                            break;
-                        }
-
-                        case 120: {
-                            ColorSpace::Hsv hsvColorB;
-                            rgbColorB.To<ColorSpace::Hsv>(&hsvColorB);
-                            ColorSpace::Hsv hsvInterpol =
-                                ChangeHueAndSaturation(hsvColorB, 1.0f - t.x, t.y);
-                            if (pow(hsvColorB.h / 360 - hsvInterpol.h / 360, 2) +
-                                    pow(hsvColorB.s - hsvInterpol.s, 2) >
-                                0.0025) {
-                                pRaw[Idx] = ToOutputColor(hsvInterpol);
-                            } else {
-                                const double DistanceToBlackWhite =
-                                    ColorSpace::Cie2000Comparison::Compare(&hsvColorB, &Black) -
-                                    ColorSpace::Cie2000Comparison::Compare(&hsvColorB, &White);
-                                pRaw[Idx] = (DistanceToBlackWhite > 0) ? ToOutputColor(Black)
-                                                                       : ToOutputColor(White);
-                            }
-                            break;
-                        }
-                    }
+    // Convert them once into all color spaces used by the swatches
+    SwatchColors Colors;
+    Colors.rgbColorA = ColorSpace::Rgb(ColorA.r * 255.0, ColorA.g * 255.0, ColorA.b * 255.0);
+    Colors.rgbColorB = ColorSpace::Rgb(ColorB.r * 255.0, ColorB.g * 255.0, ColorB.b * 255.0);
+    Colors.rgbColorA.To<ColorSpace::Cmyk>(&Colors.cmykColorA);
+    Colors.rgbColorB.To<ColorSpace::Cmyk>(&Colors.cmykColorB);
+    Colors.rgbColorA.To<ColorSpace::Hsv>(&Colors.hsvColorA);
+    Colors.rgbColorB.To<ColorSpace::Hsv>(&Colors.hsvColorB);
+    Colors.OutputA = ToUChar(ColorA);
+    Colors.OutputB = ToUChar(ColorB);
+    Colors.ContrastA = ContrastColor(Colors.hsvColorA);
+    Colors.ContrastB = ContrastColor(Colors.hsvColorB);
+
+    // Primary color swatches are plain palette entries
+    TemplateRecolor Primaries;
+    for (int Marker(211); Marker < 256; Marker++) {
+        Primaries.SetColor(static_cast<unsigned char>(Marker),
+                           (Marker == 255) ? Colors.OutputA : Colors.OutputB);
+    }
+    Primaries.Apply(Template, Resolution, pRaw);
+
+    // Dispatch table from marker value to interpolation swatch kernel
+    std::array<SwatchDispatch, 256> Dispatch;
+    for (const auto& TemplateBBox : ColorTemplateBBoxes) {
+        // Interpolation boxes
+        const unsigned char Marker = TemplateBBox.first;
+        SwatchDispatch& Entry = Dispatch[Marker];
+        bool VariesInY = false;
+        switch (Marker) {
+            case 200: Entry.Kernel = SwatchRGB; break;
+            case 180: Entry.Kernel = SwatchCMYK; break;
+            case 160: Entry.Kernel = SwatchHSV; break;
+            case 140: Entry.Kernel = SwatchValueSaturation; VariesInY = true; break;
+            case 120: Entry.Kernel = SwatchHueSaturation; VariesInY = true; break;
+            default: continue;
+        }
+        Entry.BBoxMin = TemplateBBox.second.first;
+        Entry.BBoxExtent = vec2(TemplateBBox.second.second - TemplateBBox.second.first);
+
+        // Precompute the swatch over its bbox. This is a no-op unless a color or the bbox changed.
+        SwatchLUT& LUT = SwatchLUTs[Marker];
+        const SwatchKernel Kernel = Entry.Kernel;
+        LUT.Update(ColorA, ColorB, TemplateBBox.second.first, TemplateBBox.second.second,
+                   VariesInY, [&Colors, Kernel](const vec2* t, size_t N, glm::u8vec3* pOut) {
+                       Kernel(Colors, t, N, pOut);
+                   });
+        Entry.LUT = &LUT;
+    }
+
+    // Recolor the template spans in parallel bands of rows. Other pixels are not touched.
+    ForEachRowBand(Resolution.y, Resolution.x, [&](size_t FirstRow, size_t EndRow) {
+        // Interpolation values of one span, sized once per band for the longest possible span
+        std::vector<vec2> t(Resolution.x);
+        for (const unsigned char Marker : Template.GetMarkers()) {
+            const SwatchDispatch& Entry = Dispatch[Marker];
+            if (!Entry.Kernel) continue;
+
+            const auto Spans = Template.GetSpans(Marker, FirstRow, EndRow);
+            for (const TemplateMask::Span* pSpan = Spans.first; pSpan != Spans.second; pSpan++) {
+                const size_t j = pSpan->Row;
+                glm::u8vec3* pRow = pRaw + j * Resolution.x;
+                if (Entry.LUT && Entry.LUT->Contains(pSpan->First, j) &&
+                    Entry.LUT->Contains(pSpan->End - 1, j)) {
+                    std::memcpy(pRow + pSpan->First, Entry.LUT->At(pSpan->First, j),
+                                (pSpan->End - pSpan->First) * sizeof(glm::u8vec3));
+                    continue;
                 }
+
+                // - get the interpolation values in x-direction and y-direction.
+                // -  - they run in the interval [0, 1].
+                const size_t NumPixels = pSpan->End - pSpan->First;
+                for (size_t k(0); k < NumPixels; k++) {
+                    t[k] = vec2(size2_t(pSpan->First + k, j) - Entry.BBoxMin) / Entry.BBoxExtent;
+                }
+                Entry.Kernel(Colors, t.data(), NumPixels, pRow + pSpan->First);
             }
         }
-    }
+    });
 }
 
 }  // namespace kth
@@ -9,6 +9,8 @@
  */
 
 #include <modules/labcolor/colormixing.h>
+#include <modules/labcolor/templaterecolor.h>
+#include <modules/labcolor/spectralmixing.h>
 
 
 namespace inviwo
@@ -40,6 +42,7 @@ ColorMixing::ColorMixing()
 {
     propMixingMode.addOption("AdditiveColorMixing", "Additive Color Mixing", 0);
     propMixingMode.addOption("SubtractiveColorMixing", "Subtractive Color Mixing", 1);
+    propMixingMode.addOption("SpectralColorMixing", "Spectral Color Mixing", 2);
     addProperty(propMixingMode);
 
     addProperty(propColorA);
@@ -107,55 +110,35 @@ void ColorMixing::Mix(const size2_t& Resolution, glm::u8vec3* pRaw)
     const vec3 ColorC(propColorC.get().r, propColorC.get().g, propColorC.get().b);
 
     //Mix!
-    const vec3 ColorAB  = propMixingMode.get() == 0 ? AdditiveColorMixing(ColorA, ColorB) : SubtractiveColorMixing(ColorA, ColorB);
-    const vec3 ColorBC  = propMixingMode.get() == 0 ? AdditiveColorMixing(ColorB, ColorC) : SubtractiveColorMixing(ColorB, ColorC);
-    const vec3 ColorAC  = propMixingMode.get() == 0 ? AdditiveColorMixing(ColorA, ColorC) : SubtractiveColorMixing(ColorA, ColorC);
-    const vec3 ColorABC = propMixingMode.get() == 0 ? AdditiveColorMixing(ColorAB, ColorC): SubtractiveColorMixing(ColorAB, ColorC);
-
-    //Replace colors
-    for(size_t i(0);i<Resolution.x;i++)
+    vec3 ColorAB, ColorBC, ColorAC, ColorABC;
+    if (propMixingMode.get() == 2)
+    {
+        //All combinations at once; bit 0 is A, bit 1 is B, bit 2 is C.
+        //Each processor keeps its own mixer, which only recomputes the mixes when a color changes.
+        Mixer.Update({ColorA, ColorB, ColorC}, SpectralMixer::Mode::Subtractive);
+        ColorAB  = Mixer.GetMix(0b011);
+        ColorBC  = Mixer.GetMix(0b110);
+        ColorAC  = Mixer.GetMix(0b101);
+        ColorABC = Mixer.GetMix(0b111);
+    }
+    else
     {
-        for(size_t j(0);j<Resolution.y;j++)
-        {
-            const size_t Idx = (j * Resolution.x + i);
-            if (pRaw[Idx].g == 0 && pRaw[Idx].b == 0)
-            {
-                switch (pRaw[Idx].r)
-                {
-                    case 255:
-                        pRaw[Idx] = ToUChar(ColorA);
-                        break;
-
-                    case 200:
-                        pRaw[Idx] = ToUChar(ColorB);
-                        break;
-
-                    case 220:
-                        pRaw[Idx] = ToUChar(ColorC);
-                        break;
-
-                    case 180:
-                        pRaw[Idx] = ToUChar(ColorAB);
-                        break;
-
-                    case 160:
-                        pRaw[Idx] = ToUChar(ColorBC);
-                        break;
-
-                    case 140:
-                        pRaw[Idx] = ToUChar(ColorAC);
-                        break;
-
-                    case 120:
-                        pRaw[Idx] = ToUChar(ColorABC);
-                        break;
-
-                    default:
-                        break;
-                }
-            }
-        }
+        ColorAB  = propMixingMode.get() == 0 ? AdditiveColorMixing(ColorA, ColorB) : SubtractiveColorMixing(ColorA, ColorB);
+        ColorBC  = propMixingMode.get() == 0 ? AdditiveColorMixing(ColorB, ColorC) : SubtractiveColorMixing(ColorB, ColorC);
+        ColorAC  = propMixingMode.get() == 0 ? AdditiveColorMixing(ColorA, ColorC) : SubtractiveColorMixing(ColorA, ColorC);
+        ColorABC = propMixingMode.get() == 0 ? AdditiveColorMixing(ColorAB, ColorC): SubtractiveColorMixing(ColorAB, ColorC);
     }
+
+    //Replace colors, one palette entry per template marker
+    TemplateRecolor Recolor;
+    Recolor.SetColor(255, ToUChar(ColorA));
+    Recolor.SetColor(200, ToUChar(ColorB));
+    Recolor.SetColor(220, ToUChar(ColorC));
+    Recolor.SetColor(180, ToUChar(ColorAB));
+    Recolor.SetColor(160, ToUChar(ColorBC));
+    Recolor.SetColor(140, ToUChar(ColorAC));
+    Recolor.SetColor(120, ToUChar(ColorABC));
+    Recolor.Apply(Resolution, pRaw);
 }
 
 } // namespace
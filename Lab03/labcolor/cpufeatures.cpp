@@ -0,0 +1,84 @@
+/*********************************************************************
+ *  Author  : Tino Weinkauf
+ *  Init    : Sunday, October 18, 2026 - 10:52:17
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#include <modules/labcolor/cpufeatures.h>
+
+#include <algorithm>
+#include <atomic>
+
+#if defined(LABCOLOR_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+namespace inviwo
+{
+namespace kth
+{
+namespace CpuFeatures
+{
+
+namespace
+{
+
+SimdLevel Detect()
+{
+#if defined(LABCOLOR_X86) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    //Also checks that the operating system saves the AVX registers
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+    if (__builtin_cpu_supports("sse2")) return SimdLevel::SSE2;
+    return SimdLevel::Scalar;
+#elif defined(LABCOLOR_X86) && defined(_MSC_VER)
+    int Info[4];
+    __cpuid(Info, 1);
+    const bool bOsSavesYmm = (Info[2] & (1 << 27)) && (_xgetbv(0) & 0x6) == 0x6;
+    const bool bAvx = (Info[2] & (1 << 28)) && bOsSavesYmm;
+    const bool bSse2 = (Info[3] & (1 << 26)) != 0;
+    __cpuid(Info, 0);
+    if (bAvx && Info[0] >= 7)
+    {
+        __cpuidex(Info, 7, 0);
+        if (Info[1] & (1 << 5)) return SimdLevel::AVX2;
+    }
+    return bSse2 ? SimdLevel::SSE2 : SimdLevel::Scalar;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+std::atomic<int>& CurrentLevel()
+{
+    static std::atomic<int> Level(static_cast<int>(Supported()));
+    return Level;
+}
+
+} // namespace
+
+SimdLevel Supported()
+{
+    static const SimdLevel Level = Detect();
+    return Level;
+}
+
+SimdLevel Current()
+{
+    return static_cast<SimdLevel>(CurrentLevel().load(std::memory_order_relaxed));
+}
+
+void SetCurrent(SimdLevel Level)
+{
+    const int Capped = std::min(static_cast<int>(Level), static_cast<int>(Supported()));
+    CurrentLevel().store(Capped, std::memory_order_relaxed);
+}
+
+} // namespace CpuFeatures
+} // namespace
+} // namespace
@@ -0,0 +1,58 @@
+/*********************************************************************
+ *  Author  : Tino Weinkauf
+ *  Init    : Sunday, October 18, 2026 - 10:52:17
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#pragma once
+
+#include <modules/labcolor/labcolormoduledefine.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define LABCOLOR_X86
+#endif
+
+//Vector paths are compiled for their instruction set function by function, so that the
+//module builds without architecture flags and picks the widest path at runtime.
+#if defined(LABCOLOR_X86) && (defined(__GNUC__) || defined(__clang__))
+#define LABCOLOR_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define LABCOLOR_TARGET_AVX2
+#endif
+
+namespace inviwo
+{
+namespace kth
+{
+
+/*  Instruction sets for the vector paths of the color batch, recolor and Delta E code.
+    SSE2 is part of every x86-64 CPU and needs no check.
+*/
+namespace CpuFeatures
+{
+
+enum class SimdLevel
+{
+    Scalar = 0,
+    SSE2 = 1,
+    AVX2 = 2
+};
+
+///Widest instruction set of this CPU (and operating system).
+IVW_MODULE_LABCOLOR_API SimdLevel Supported();
+
+///The instruction set the vector paths dispatch to, the supported one unless capped.
+IVW_MODULE_LABCOLOR_API SimdLevel Current();
+
+///Caps the instruction set, to compare the paths in tests. Levels above the supported one
+///are lowered to it.
+IVW_MODULE_LABCOLOR_API void SetCurrent(SimdLevel Level);
+
+} // namespace CpuFeatures
+
+} // namespace
+} // namespace
@@ -0,0 +1,378 @@
+/*********************************************************************
+ *  Author  : Tino Weinkauf
+ *  Init    : Saturday, October 17, 2026 - 22:38:15
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#include <modules/labcolor/deltae2000.h>
+#include <modules/labcolor/colorbatch.h>
+#include <modules/labcolor/cpufeatures.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#if defined(LABCOLOR_X86)
+#include <immintrin.h>
+#endif
+
+namespace inviwo
+{
+namespace kth
+{
+namespace ColorBatch
+{
+
+namespace
+{
+
+constexpr float Pi = 3.14159265358979f;
+constexpr float DegToRad = Pi / 180.0f;
+constexpr float Pow25To7 = 6103515625.0f;
+// Colors per batch of bounds, kept on the stack
+constexpr size_t BoundsChunk = 256;
+// Below this product of chromas, hue angles are meaningless (as in ColorSpace)
+constexpr float ChromaEpsilon = 1e-5f;
+// Range of the hue weight T over all hues, and the largest factor of R_C in R_T
+constexpr float MinT = 0.36f, MaxT = 1.58f;
+constexpr float Sin60 = 0.8660254f;
+// Widening of the bounds against the rounding of the full formula
+constexpr float RelativeSlack = 1e-3f;
+constexpr float AbsoluteSlack = 1e-3f;
+
+float Pow7(float x)
+{
+    const float x2 = x * x;
+    return x2 * x2 * x2 * x;
+}
+
+float LightnessWeight(float MeanL)
+{
+    const float d2 = (MeanL - 50) * (MeanL - 50);
+    return 1 + 0.015f * d2 / std::sqrt(20 + d2);
+}
+
+float HueAngle(float B, float APrime)
+{
+    const float h = std::atan2(B, APrime);
+    return (h < 0) ? h + 2 * Pi : h;
+}
+
+/*  The full CIEDE2000 formula between one color and a reference.
+*/
+float FullDeltaE2000(float L, float A, float B, float Chroma, const LabReference& Ref)
+{
+    const float MeanC7 = Pow7((Chroma + Ref.Chroma) / 2);
+    const float G = 0.5f * (1 - std::sqrt(MeanC7 / (MeanC7 + Pow25To7)));
+    const float A1 = A * (1 + G), A2 = Ref.A * (1 + G);
+    const float C1 = std::sqrt(A1 * A1 + B * B), C2 = std::sqrt(A2 * A2 + Ref.B * Ref.B);
+    const float H1 = HueAngle(B, A1), H2 = HueAngle(Ref.B, A2);
+    const float ChromaProduct = C1 * C2;
+
+    float dh = H2 - H1;
+    if (ChromaProduct < ChromaEpsilon) dh = 0;
+    else if (dh > Pi) dh -= 2 * Pi;
+    else if (dh < -Pi) dh += 2 * Pi;
+
+    const float dL = Ref.L - L;
+    const float dC = C2 - C1;
+    const float dH = 2 * std::sqrt(ChromaProduct) * std::sin(dh / 2);
+
+    float MeanH = H1 + H2;
+    if (ChromaProduct >= ChromaEpsilon)
+    {
+        if (std::abs(H1 - H2) <= Pi) MeanH = (H1 + H2) / 2;
+        else if (H1 + H2 < 2 * Pi) MeanH = (H1 + H2 + 2 * Pi) / 2;
+        else MeanH = (H1 + H2 - 2 * Pi) / 2;
+    }
+    const float T = 1 - 0.17f * std::cos(MeanH - 30 * DegToRad) + 0.24f * std::cos(2 * MeanH) +
+                    0.32f * std::cos(3 * MeanH + 6 * DegToRad) -
+                    0.20f * std::cos(4 * MeanH - 63 * DegToRad);
+
+    const float MeanC = (C1 + C2) / 2;
+    const float SL = LightnessWeight((L + Ref.L) / 2);
+    const float SC = 1 + 0.045f * MeanC;
+    const float SH = 1 + 0.015f * MeanC * T;
+    const float MeanCPrime7 = Pow7(MeanC);
+    const float RC = 2 * std::sqrt(MeanCPrime7 / (MeanCPrime7 + Pow25To7));
+    const float HueDeviation = (MeanH / DegToRad - 275) / 25;
+    const float RT = -std::sin(60 * DegToRad * std::exp(-HueDeviation * HueDeviation)) * RC;
+
+    const float LTerm = dL / SL, CTerm = dC / SC, HTerm = dH / SH;
+    return std::sqrt(LTerm * LTerm + CTerm * CTerm + HTerm * HTerm + RT * CTerm * HTerm);
+}
+
+#if defined(LABCOLOR_X86)
+
+LABCOLOR_TARGET_AVX2
+inline __m256 Abs8(__m256 x)
+{
+    return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), x);
+}
+
+LABCOLOR_TARGET_AVX2
+inline __m256 Pow7(__m256 x)
+{
+    const __m256 x2 = _mm256_mul_ps(x, x);
+    return _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(x2, x2), x2), x);
+}
+
+/*  DeltaE2000Bounds() for eight colors per instruction, in the same order of operations.
+    Returns how many colors it did.
+*/
+LABCOLOR_TARGET_AVX2
+size_t DeltaE2000Bounds8(size_t N, const float* L, const float* A, const float* B,
+                         const LabReference& Ref, float* Lower, float* Upper)
+{
+    const __m256 One = _mm256_set1_ps(1.0f);
+    const __m256 Half = _mm256_set1_ps(0.5f);
+    const __m256 Pow25 = _mm256_set1_ps(Pow25To7);
+    const __m256 RefL = _mm256_set1_ps(Ref.L);
+    const __m256 RefA = _mm256_set1_ps(Ref.A);
+    const __m256 RefB = _mm256_set1_ps(Ref.B);
+    const __m256 RefChroma = _mm256_set1_ps(Ref.Chroma);
+
+    size_t i(0);
+    for (; i + 8 <= N; i += 8)
+    {
+        const __m256 l = _mm256_loadu_ps(L + i);
+        const __m256 a = _mm256_loadu_ps(A + i);
+        const __m256 b = _mm256_loadu_ps(B + i);
+        const __m256 b2 = _mm256_mul_ps(b, b);
+
+        const __m256 Chroma = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(a, a), b2));
+        const __m256 MeanC7 = Pow7(_mm256_mul_ps(_mm256_add_ps(Chroma, RefChroma), Half));
+        const __m256 G = _mm256_mul_ps(
+            Half, _mm256_sub_ps(One, _mm256_sqrt_ps(
+                                         _mm256_div_ps(MeanC7, _mm256_add_ps(MeanC7, Pow25)))));
+        const __m256 Stretch = _mm256_add_ps(One, G);
+        const __m256 A1 = _mm256_mul_ps(a, Stretch), A2 = _mm256_mul_ps(RefA, Stretch);
+        const __m256 C1 = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(A1, A1), b2));
+        const __m256 C2 =
+            _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(A2, A2), _mm256_mul_ps(RefB, RefB)));
+        const __m256 MeanC = _mm256_mul_ps(_mm256_add_ps(C1, C2), Half);
+        const __m256 MeanCPrime7 = Pow7(MeanC);
+        const __m256 MaxRT = _mm256_mul_ps(
+            _mm256_set1_ps(2 * Sin60),
+            _mm256_sqrt_ps(_mm256_div_ps(MeanCPrime7, _mm256_add_ps(MeanCPrime7, Pow25))));
+
+        //LightnessWeight() of the mean lightness
+        const __m256 dMeanL =
+            _mm256_sub_ps(_mm256_mul_ps(_mm256_add_ps(l, RefL), Half), _mm256_set1_ps(50));
+        const __m256 d2 = _mm256_mul_ps(dMeanL, dMeanL);
+        const __m256 SL = _mm256_add_ps(
+            One, _mm256_div_ps(_mm256_mul_ps(_mm256_set1_ps(0.015f), d2),
+                               _mm256_sqrt_ps(_mm256_add_ps(_mm256_set1_ps(20), d2))));
+        const __m256 x = _mm256_div_ps(_mm256_sub_ps(RefL, l), SL);
+
+        const __m256 dC = _mm256_sub_ps(C2, C1);
+        const __m256 ChromaWeight = _mm256_mul_ps(_mm256_set1_ps(0.015f), MeanC);
+        const __m256 y = _mm256_div_ps(
+            Abs8(dC), _mm256_add_ps(One, _mm256_mul_ps(_mm256_set1_ps(0.045f), MeanC)));
+        const __m256 dA = _mm256_sub_ps(A2, A1), dB = _mm256_sub_ps(RefB, b);
+        const __m256 dH = _mm256_sqrt_ps(Abs8(_mm256_sub_ps(
+            _mm256_add_ps(_mm256_mul_ps(dA, dA), _mm256_mul_ps(dB, dB)), _mm256_mul_ps(dC, dC))));
+        const __m256 MinZ = _mm256_div_ps(
+            dH, _mm256_add_ps(One, _mm256_mul_ps(ChromaWeight, _mm256_set1_ps(MaxT))));
+        const __m256 MaxZ = _mm256_div_ps(
+            dH, _mm256_add_ps(One, _mm256_mul_ps(ChromaWeight, _mm256_set1_ps(MinT))));
+
+        const __m256 RTy = _mm256_mul_ps(MaxRT, y);
+        const __m256 zOpt = _mm256_mul_ps(RTy, Half);
+        const __m256 zAboveMin = _mm256_mul_ps(
+            _mm256_add_ps(_mm256_add_ps(zOpt, MinZ), Abs8(_mm256_sub_ps(zOpt, MinZ))), Half);
+        const __m256 z = _mm256_mul_ps(
+            _mm256_sub_ps(_mm256_add_ps(zAboveMin, MaxZ), Abs8(_mm256_sub_ps(zAboveMin, MaxZ))),
+            Half);
+        const __m256 xy2 = _mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y));
+        const __m256 Lower2 = Abs8(_mm256_sub_ps(_mm256_add_ps(xy2, _mm256_mul_ps(z, z)),
+                                                 _mm256_mul_ps(RTy, z)));
+        const __m256 Upper2 = _mm256_add_ps(_mm256_add_ps(xy2, _mm256_mul_ps(MaxZ, MaxZ)),
+                                            _mm256_mul_ps(RTy, MaxZ));
+        const __m256 LowerSlack = _mm256_set1_ps(1 - RelativeSlack);
+        const __m256 UpperSlack = _mm256_set1_ps(1 + RelativeSlack);
+        _mm256_storeu_ps(Lower + i,
+                         _mm256_sub_ps(_mm256_mul_ps(_mm256_sqrt_ps(Lower2), LowerSlack),
+                                       _mm256_set1_ps(AbsoluteSlack)));
+        _mm256_storeu_ps(Upper + i,
+                         _mm256_add_ps(_mm256_mul_ps(_mm256_sqrt_ps(Upper2), UpperSlack),
+                                       _mm256_set1_ps(AbsoluteSlack)));
+    }
+    return i;
+}
+
+#endif
+
+/*  Lower and upper bounds on CIEDE2000 without any trigonometry.
+
+    Everything except the hue angles can be computed exactly and cheaply: the a-axis
+    stretch G, the chromas C', dL' and dC', S_L, S_C and R_C, and also
+    dH'^2 = (1 + G)^2 da^2 + db^2 - dC'^2. Only S_H and R_T depend on the mean hue.
+    Over all hues, T stays within [0.36, 1.58] and |R_T| <= sin(60 deg) R_C. With
+    y = dC'/S_C and z = dH'/S_H, CIEDE2000^2 lies between
+      x^2 + y^2 + z^2 - max|R_T| |y| z  minimized over z in [zMin, zMax], and
+      x^2 + y^2 + zMax^2 + max|R_T| |y| zMax.
+
+    There are neither branches nor comparisons (min and max are written with abs). The
+    compiler would still only vectorize the loop with -fno-math-errno because of
+    std::sqrt, so on CPUs with AVX2 eight colors at a time go through DeltaE2000Bounds8().
+*/
+void DeltaE2000Bounds(size_t N, const float* L, const float* A, const float* B,
+                      const LabReference& Ref, float* Lower, float* Upper)
+{
+    size_t i(0);
+#if defined(LABCOLOR_X86)
+    if (CpuFeatures::Current() >= CpuFeatures::SimdLevel::AVX2)
+    {
+        i = DeltaE2000Bounds8(N, L, A, B, Ref, Lower, Upper);
+    }
+#endif
+
+    const float RefL = Ref.L, RefA = Ref.A, RefB = Ref.B, RefChroma = Ref.Chroma;
+    for (; i < N; i++)
+    {
+        const float Chroma = std::sqrt(A[i] * A[i] + B[i] * B[i]);
+        const float MeanC7 = Pow7((Chroma + RefChroma) / 2);
+        const float G = 0.5f * (1 - std::sqrt(MeanC7 / (MeanC7 + Pow25To7)));
+        const float A1 = A[i] * (1 + G), A2 = RefA * (1 + G);
+        const float C1 = std::sqrt(A1 * A1 + B[i] * B[i]);
+        const float C2 = std::sqrt(A2 * A2 + RefB * RefB);
+        const float MeanC = (C1 + C2) / 2;
+        const float MeanCPrime7 = Pow7(MeanC);
+        const float MaxRT = 2 * Sin60 * std::sqrt(MeanCPrime7 / (MeanCPrime7 + Pow25To7));
+
+        const float x = (RefL - L[i]) / LightnessWeight((L[i] + RefL) / 2);
+        const float y = std::abs(C2 - C1) / (1 + 0.045f * MeanC);
+        // dH'^2 is only negative by rounding
+        const float dA = A2 - A1, dB = RefB - B[i];
+        const float dH = std::sqrt(std::abs(dA * dA + dB * dB - (C2 - C1) * (C2 - C1)));
+        const float MinZ = dH / (1 + 0.015f * MeanC * MaxT);
+        const float MaxZ = dH / (1 + 0.015f * MeanC * MinT);
+
+        // The lower bound is smallest at z = MaxRT y / 2, clamped to [MinZ, MaxZ]
+        const float zOpt = MaxRT * y / 2;
+        const float zAboveMin = (zOpt + MinZ + std::abs(zOpt - MinZ)) / 2;
+        const float z = (zAboveMin + MaxZ - std::abs(zAboveMin - MaxZ)) / 2;
+        const float Lower2 = std::abs(x * x + y * y + z * z - MaxRT * y * z);
+        const float Upper2 = x * x + y * y + MaxZ * MaxZ + MaxRT * y * MaxZ;
+        Lower[i] = std::sqrt(Lower2) * (1 - RelativeSlack) - AbsoluteSlack;
+        Upper[i] = std::sqrt(Upper2) * (1 + RelativeSlack) + AbsoluteSlack;
+    }
+}
+
+/*  Evaluates the full formula for the colors in Indices only, as one dense loop.
+*/
+void DeltaE2000Subset(const std::vector<size_t>& Indices, const float* L, const float* A,
+                      const float* B, const LabReference& Reference, std::vector<float>& DeltaE)
+{
+    DeltaE.resize(Indices.size());
+    for (size_t k(0); k < Indices.size(); k++)
+    {
+        const size_t i = Indices[k];
+        DeltaE[k] = FullDeltaE2000(L[i], A[i], B[i], std::sqrt(A[i] * A[i] + B[i] * B[i]),
+                                   Reference);
+    }
+}
+
+} // namespace
+
+LabReference::LabReference(float L_, float A_, float B_)
+    : L(L_), A(A_), B(B_), Chroma(std::sqrt(A_ * A_ + B_ * B_))
+{
+}
+
+LabReference LabReference::FromRgb(float R, float G, float B)
+{
+    float Lab[3];
+    RgbToLab(1, &R, &G, &B, &Lab[0], &Lab[1], &Lab[2]);
+    return LabReference(Lab[0], Lab[1], Lab[2]);
+}
+
+const LabReference& LabReference::Black()
+{
+    static const LabReference Reference = FromRgb(0, 0, 0);
+    return Reference;
+}
+
+const LabReference& LabReference::White()
+{
+    static const LabReference Reference = FromRgb(255, 255, 255);
+    return Reference;
+}
+
+void DeltaE2000(size_t N, const float* L, const float* A, const float* B,
+                const LabReference& Reference, float* DeltaE)
+{
+    for (size_t i(0); i < N; i++)
+    {
+        DeltaE[i] = FullDeltaE2000(L[i], A[i], B[i], std::sqrt(A[i] * A[i] + B[i] * B[i]),
+                                   Reference);
+    }
+}
+
+void FartherFromFirst(size_t N, const float* L, const float* A, const float* B,
+                      const LabReference& First, const LabReference& Second,
+                      unsigned char* IsFarther)
+{
+    std::vector<size_t> Undecided;
+    for (size_t Begin(0); Begin < N; Begin += BoundsChunk)
+    {
+        const size_t Count = std::min(BoundsChunk, N - Begin);
+        float LowerFirst[BoundsChunk], UpperFirst[BoundsChunk];
+        float LowerSecond[BoundsChunk], UpperSecond[BoundsChunk];
+        DeltaE2000Bounds(Count, L + Begin, A + Begin, B + Begin, First, LowerFirst, UpperFirst);
+        DeltaE2000Bounds(Count, L + Begin, A + Begin, B + Begin, Second, LowerSecond,
+                         UpperSecond);
+
+        for (size_t k(0); k < Count; k++)
+        {
+            if (LowerFirst[k] > UpperSecond[k]) IsFarther[Begin + k] = 1;
+            else if (UpperFirst[k] <= LowerSecond[k]) IsFarther[Begin + k] = 0;
+            else Undecided.push_back(Begin + k);
+        }
+    }
+    if (Undecided.empty()) return;
+
+    std::vector<float> DeltaEFirst, DeltaESecond;
+    DeltaE2000Subset(Undecided, L, A, B, First, DeltaEFirst);
+    DeltaE2000Subset(Undecided, L, A, B, Second, DeltaESecond);
+    for (size_t k(0); k < Undecided.size(); k++)
+    {
+        IsFarther[Undecided[k]] = DeltaEFirst[k] > DeltaESecond[k];
+    }
+}
+
+void WithinDeltaE2000(size_t N, const float* L, const float* A, const float* B,
+                      const LabReference& Reference, float MaxDeltaE, unsigned char* IsWithin)
+{
+    std::vector<size_t> Undecided;
+    for (size_t Begin(0); Begin < N; Begin += BoundsChunk)
+    {
+        const size_t Count = std::min(BoundsChunk, N - Begin);
+        float Lower[BoundsChunk], Upper[BoundsChunk];
+        DeltaE2000Bounds(Count, L + Begin, A + Begin, B + Begin, Reference, Lower, Upper);
+
+        for (size_t k(0); k < Count; k++)
+        {
+            if (Upper[k] <= MaxDeltaE) IsWithin[Begin + k] = 1;
+            else if (Lower[k] > MaxDeltaE) IsWithin[Begin + k] = 0;
+            else Undecided.push_back(Begin + k);
+        }
+    }
+    if (Undecided.empty()) return;
+
+    std::vector<float> DeltaE;
+    DeltaE2000Subset(Undecided, L, A, B, Reference, DeltaE);
+    for (size_t k(0); k < Undecided.size(); k++)
+    {
+        IsWithin[Undecided[k]] = DeltaE[k] <= MaxDeltaE;
+    }
+}
+
+} // namespace ColorBatch
+} // namespace
+} // namespace
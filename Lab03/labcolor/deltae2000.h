@@ -0,0 +1,78 @@
+/*********************************************************************
+ *  Author  : Tino Weinkauf
+ *  Init    : Saturday, October 17, 2026 - 22:38:15
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#pragma once
+
+#include <modules/labcolor/labcolormoduledefine.h>
+
+#include <cstddef>
+
+namespace inviwo
+{
+namespace kth
+{
+namespace ColorBatch
+{
+
+/** \class LabReference
+    \brief A fixed color that many colors are compared against with CIEDE2000.
+
+    Keeps the Lab coordinates and the chroma of the color, so they are computed
+    once instead of for every comparison.
+
+    @author Tino Weinkauf
+*/
+struct IVW_MODULE_LABCOLOR_API LabReference
+{
+    LabReference(float L, float A, float B);
+
+    ///Reference from an RGB color with components in [0, 255]
+    static LabReference FromRgb(float R, float G, float B);
+
+    static const LabReference& Black();
+    static const LabReference& White();
+
+    float L, A, B;
+    float Chroma;
+};
+
+/*  CIEDE2000 color differences of N Lab colors to a reference, with the same formula
+    as ColorSpace::Cie2000Comparison.
+
+    This is a scalar loop, one color at a time. The formula needs atan2, sin, cos and exp
+    per color, which do not vectorize without a vector math library.
+*/
+IVW_MODULE_LABCOLOR_API void DeltaE2000(size_t N, const float* L, const float* A, const float* B,
+                                        const LabReference& Reference, float* DeltaE);
+
+/*  For N Lab colors, whether each is further away from First than from Second in CIEDE2000.
+
+    This is the decision between two fixed colors such as Black and White. Most colors
+    are decided by lower and upper bounds on CIEDE2000 that need no trigonometry and are
+    computed eight colors at a time on CPUs with AVX2; only the remaining ones go through
+    the scalar full formula. The bounds take the place of a pre-test with the Euclidean Lab
+    distance (CIE76), which is no bound on CIEDE2000 in either direction and therefore
+    cannot decide any color on its own.
+*/
+IVW_MODULE_LABCOLOR_API void FartherFromFirst(size_t N, const float* L, const float* A,
+                                              const float* B, const LabReference& First,
+                                              const LabReference& Second,
+                                              unsigned char* IsFarther);
+
+/*  For N Lab colors, whether each is within MaxDeltaE of the reference in CIEDE2000.
+    Colors that are clearly inside or outside are decided by the cheap bounds alone.
+*/
+IVW_MODULE_LABCOLOR_API void WithinDeltaE2000(size_t N, const float* L, const float* A,
+                                              const float* B, const LabReference& Reference,
+                                              float MaxDeltaE, unsigned char* IsWithin);
+
+} // namespace ColorBatch
+} // namespace
+} // namespace
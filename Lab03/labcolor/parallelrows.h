@@ -0,0 +1,56 @@
+/*********************************************************************
+ *  Author  : Tino Weinkauf
+ *  Init    : Saturday, October 17, 2026 - 20:03:51
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#pragma once
+
+#include <inviwo/core/util/foreach.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace inviwo {
+namespace kth {
+
+/*  Splits the rows [0, NumRows) of an image into contiguous bands and calls
+    Function(FirstRow, EndRow) for each band as one job on Inviwo's thread pool.
+    The pool threads outlive the call, so their thread_local state is kept as well.
+
+    Small images are processed on the calling thread, since dispatching costs more
+    than recoloring a few thousand pixels. Function must only write to the rows it
+    is given.
+*/
+template <typename Function>
+void ForEachRowBand(const size_t NumRows, const size_t RowLength, Function&& F) {
+    constexpr size_t MinPixelsPerThread = size_t(1) << 16;
+
+    const size_t NumPixels = NumRows * RowLength;
+    const size_t MaxThreads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    const size_t NumBands =
+        std::min({MaxThreads, NumRows, std::max<size_t>(1, NumPixels / MinPixelsPerThread)});
+
+    if (NumBands <= 1) {
+        F(size_t(0), NumRows);
+        return;
+    }
+
+    std::vector<std::pair<size_t, size_t>> Bands(NumBands);
+    for (size_t Band(0); Band < NumBands; Band++) {
+        Bands[Band] = {Band * NumRows / NumBands, (Band + 1) * NumRows / NumBands};
+    }
+    util::forEachParallel(
+        Bands, [&F](const std::pair<size_t, size_t>& Band) { F(Band.first, Band.second); },
+        NumBands);
+}
+
+}  // namespace kth
+}  // namespace inviwo
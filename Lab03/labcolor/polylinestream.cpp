@@ -0,0 +1,277 @@
+/*********************************************************************
+ *  Author  : Tino Weinkauf
+ *  Init    : Sunday, October 18, 2026 - 02:31:50
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#include <modules/labsubdivision/polylinestream.h>
+#include <modules/labsubdivision/workranges.h>
+
+#include <cstring>
+#include <filesystem>
+#include <limits>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace inviwo
+{
+namespace kth
+{
+
+namespace
+{
+
+constexpr char Magic[8] = {'K', 'T', 'H', 'P', 'L', 'Y', '0', '1'};
+constexpr size_t HeaderSize = sizeof(Magic) + sizeof(uint64_t);
+
+} // namespace
+
+void TransformPoints(const mat4& Trafo, const vec3* pIn, const size_t N, vec3* pOut)
+{
+    const bool bAffine = Trafo[0][3] == 0 && Trafo[1][3] == 0 && Trafo[2][3] == 0 && Trafo[3][3] == 1;
+
+    //The matrix entries are read once, outside the loops
+    const float m00 = Trafo[0][0], m01 = Trafo[0][1], m02 = Trafo[0][2], m03 = Trafo[0][3];
+    const float m10 = Trafo[1][0], m11 = Trafo[1][1], m12 = Trafo[1][2], m13 = Trafo[1][3];
+    const float m20 = Trafo[2][0], m21 = Trafo[2][1], m22 = Trafo[2][2], m23 = Trafo[2][3];
+    const float m30 = Trafo[3][0], m31 = Trafo[3][1], m32 = Trafo[3][2], m33 = Trafo[3][3];
+    if (bAffine)
+    {
+        for (size_t i(0); i < N; i++)
+        {
+            const float x = pIn[i].x, y = pIn[i].y, z = pIn[i].z;
+            pOut[i] = vec3(m00 * x + m10 * y + m20 * z + m30,
+                           m01 * x + m11 * y + m21 * z + m31,
+                           m02 * x + m12 * y + m22 * z + m32);
+        }
+    }
+    else
+    {
+        for (size_t i(0); i < N; i++)
+        {
+            const float x = pIn[i].x, y = pIn[i].y, z = pIn[i].z;
+            const float InvW = 1.0f / (m03 * x + m13 * y + m23 * z + m33);
+            pOut[i] = vec3((m00 * x + m10 * y + m20 * z + m30) * InvW,
+                           (m01 * x + m11 * y + m21 * z + m31) * InvW,
+                           (m02 * x + m12 * y + m22 * z + m32) * InvW);
+        }
+    }
+}
+
+bool MappedPolylineFile::Open(const std::string& Path)
+{
+    Close();
+
+#ifdef _WIN32
+    hFile = CreateFileA(Path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                        FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        hFile = nullptr;
+        return false;
+    }
+    LARGE_INTEGER FileSize;
+    if (!GetFileSizeEx(hFile, &FileSize) || FileSize.QuadPart < LONGLONG(HeaderSize))
+    {
+        Close();
+        return false;
+    }
+    Size = size_t(FileSize.QuadPart);
+    hMapping = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!hMapping)
+    {
+        Close();
+        return false;
+    }
+    pData = static_cast<const unsigned char*>(MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0));
+#else
+    FileDescriptor = open(Path.c_str(), O_RDONLY);
+    if (FileDescriptor < 0) return false;
+    struct stat FileStatus;
+    if (fstat(FileDescriptor, &FileStatus) != 0 || size_t(FileStatus.st_size) < HeaderSize)
+    {
+        Close();
+        return false;
+    }
+    Size = size_t(FileStatus.st_size);
+    void* pMapping = mmap(nullptr, Size, PROT_READ, MAP_PRIVATE, FileDescriptor, 0);
+    if (pMapping != MAP_FAILED)
+    {
+        pData = static_cast<const unsigned char*>(pMapping);
+        madvise(pMapping, Size, MADV_SEQUENTIAL);
+    }
+#endif
+    if (!pData || std::memcmp(pData, Magic, sizeof(Magic)) != 0)
+    {
+        Close();
+        return false;
+    }
+
+    std::memcpy(&NumPolylines, pData + sizeof(Magic), sizeof(uint64_t));
+    Cursor = Released = HeaderSize;
+    return true;
+}
+
+void MappedPolylineFile::Close()
+{
+#ifdef _WIN32
+    if (pData) UnmapViewOfFile(pData);
+    if (hMapping) CloseHandle(hMapping);
+    if (hFile) CloseHandle(hFile);
+    hMapping = hFile = nullptr;
+#else
+    if (pData) munmap(const_cast<unsigned char*>(pData), Size);
+    if (FileDescriptor >= 0) close(FileDescriptor);
+    FileDescriptor = -1;
+#endif
+    pData = nullptr;
+    Size = Cursor = Released = 0;
+    NumPolylines = NumRead = 0;
+    bTruncated = false;
+}
+
+bool MappedPolylineFile::NextChunk(const size_t MaxVertices, std::vector<Polyline>& Chunk)
+{
+    Chunk.clear();
+    if (!pData) return false;
+
+#ifndef _WIN32
+    //The previous chunk is done; its pages can be dropped and will not be read again
+    const size_t PageSize = size_t(sysconf(_SC_PAGESIZE));
+    const size_t Done = (Cursor / PageSize) * PageSize;
+    if (Done > Released)
+    {
+        madvise(const_cast<unsigned char*>(pData) + Released, Done - Released, MADV_DONTNEED);
+        Released = Done;
+    }
+#endif
+
+    size_t NumVertices(0);
+    while (NumRead < NumPolylines)
+    {
+        uint32_t NumLineVertices;
+        if (Size - Cursor < sizeof(uint32_t))
+        {
+            bTruncated = true;
+            break;
+        }
+        std::memcpy(&NumLineVertices, pData + Cursor, sizeof(uint32_t));
+        //A polyline that does not fit anymore starts the next chunk
+        if (!Chunk.empty() && NumVertices + NumLineVertices > MaxVertices) break;
+
+        const size_t RecordSize = sizeof(uint32_t) + size_t(NumLineVertices) * sizeof(vec3);
+        if (Size - Cursor < RecordSize)
+        {
+            bTruncated = true;
+            break;
+        }
+
+        //Records are 4-byte aligned, so the floats can be used in place
+        Chunk.push_back({reinterpret_cast<const vec3*>(pData + Cursor + sizeof(uint32_t)),
+                         size_t(NumLineVertices)});
+        NumVertices += NumLineVertices;
+        Cursor += RecordSize;
+        NumRead++;
+    }
+    return !Chunk.empty();
+}
+
+bool PolylineFileWriter::Open(const std::string& Path)
+{
+    File.open(Path, std::ios::binary | std::ios::trunc);
+    NumPolylines = 0;
+    File.write(Magic, sizeof(Magic));
+    File.write(reinterpret_cast<const char*>(&NumPolylines), sizeof(uint64_t));
+    return bool(File);
+}
+
+bool PolylineFileWriter::Append(const vec3* pVertices, const size_t NumVertices)
+{
+    if (NumVertices > std::numeric_limits<uint32_t>::max()) return false;
+
+    const uint32_t NumLineVertices = uint32_t(NumVertices);
+    File.write(reinterpret_cast<const char*>(&NumLineVertices), sizeof(uint32_t));
+    File.write(reinterpret_cast<const char*>(pVertices), NumVertices * sizeof(vec3));
+    NumPolylines++;
+    return bool(File);
+}
+
+bool PolylineFileWriter::Close()
+{
+    if (!File.is_open()) return false;
+    File.seekp(sizeof(Magic));
+    File.write(reinterpret_cast<const char*>(&NumPolylines), sizeof(uint64_t));
+    const bool bWritten = bool(File);
+    File.close();
+    return bWritten;
+}
+
+bool SubdividePolylineFile(const std::string& InPath, const std::string& OutPath,
+                           const mat4& Trafo, const ChaikinSubdivision::Method SubdivisionMethod,
+                           const size_t MinNumPoints, const float Tolerance,
+                           const size_t MaxChunkVertices)
+{
+    //Truncating the output would pull the pages out from under the mapped input
+    std::error_code Error;
+    if (std::filesystem::equivalent(InPath, OutPath, Error)) return false;
+
+    MappedPolylineFile In;
+    PolylineFileWriter Out;
+    if (!In.Open(InPath) || !Out.Open(OutPath)) return false;
+
+    std::vector<MappedPolylineFile::Polyline> Chunk;
+    std::vector<std::vector<vec3>> Curves;
+    std::vector<size_t> Offsets;
+    while (In.NextChunk(MaxChunkVertices, Chunk))
+    {
+        Offsets.assign(Chunk.size() + 1, 0);
+        for (size_t p(0); p < Chunk.size(); p++)
+        {
+            Offsets[p + 1] = Offsets[p] + Chunk[p].NumVertices;
+        }
+
+        //The curve buffers are reused from chunk to chunk
+        if (Curves.size() < Chunk.size()) Curves.resize(Chunk.size());
+        ForEachWorkRange(Offsets, [&](size_t First, size_t End)
+        {
+            ChaikinSubdivision Subdivision;
+            std::vector<vec3> ControlPolygon;
+            for (size_t p(First); p < End; p++)
+            {
+                ControlPolygon.resize(Chunk[p].NumVertices);
+                TransformPoints(Trafo, Chunk[p].pVertices, Chunk[p].NumVertices, ControlPolygon.data());
+
+                //Closed loops may repeat their first point at the end
+                if (ControlPolygon.size() > 1 && ControlPolygon.front() == ControlPolygon.back())
+                {
+                    ControlPolygon.pop_back();
+                }
+                Subdivision.Subdivide(SubdivisionMethod, ControlPolygon, MinNumPoints, Tolerance, Curves[p]);
+            }
+        });
+
+        for (size_t p(0); p < Chunk.size(); p++)
+        {
+            if (!Out.Append(Curves[p].data(), Curves[p].size())) return false;
+        }
+    }
+
+    return Out.Close() && In.IsComplete();
+}
+
+} // namespace
+} // namespace
@@ -0,0 +1,136 @@
+/*********************************************************************
+ *  Author  : Tino Weinkauf
+ *  Init    : Sunday, October 18, 2026 - 02:31:50
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#pragma once
+
+#include <modules/labsubdivision/labsubdivisionmoduledefine.h>
+#include <modules/labsubdivision/chaikinsubdivision.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace inviwo
+{
+namespace kth
+{
+
+/*  Transforms N points with a world matrix, writing the results to pOut.
+    Affine matrices skip the homogeneous division. pIn and pOut may be the same array.
+*/
+IVW_MODULE_LABSUBDIVISION_API void TransformPoints(const mat4& Trafo, const vec3* pIn, size_t N,
+                                                   vec3* pOut);
+
+/** \class MappedPolylineFile
+    \brief Read-only, memory-mapped binary polyline file that is read in chunks.
+
+    The file consists of the 8 characters "KTHPLY01", the number of polylines as
+    uint64, and one record per polyline: the number of its vertices as uint32 followed
+    by the vertices as three floats each. Polylines are closed loops.
+
+    The vertices are handed out as views into the mapping, without copying. Chunks are
+    read front to back; the pages of finished chunks are given back to the operating
+    system, so files larger than the main memory can be processed.
+
+    @author Tino Weinkauf
+*/
+class IVW_MODULE_LABSUBDIVISION_API MappedPolylineFile
+{
+//Types
+public:
+    struct Polyline
+    {
+        const vec3* pVertices;
+        size_t NumVertices;
+    };
+
+//Construction / Deconstruction
+public:
+    MappedPolylineFile() = default;
+    MappedPolylineFile(const MappedPolylineFile&) = delete;
+    MappedPolylineFile& operator=(const MappedPolylineFile&) = delete;
+    ~MappedPolylineFile() { Close(); }
+
+//Methods
+public:
+    ///Maps the file. Returns false if it cannot be mapped or has no valid header.
+    bool Open(const std::string& Path);
+
+    void Close();
+
+    ///Number of polylines according to the header
+    uint64_t GetNumPolylines() const { return NumPolylines; }
+
+    /** Views of the next polylines with at most MaxVertices vertices in total. A single
+        polyline with more vertices makes a chunk of its own. The views stay valid until
+        the next call. Returns false at the end.
+    */
+    bool NextChunk(size_t MaxVertices, std::vector<Polyline>& Chunk);
+
+    ///Whether all polylines of the header have been read, without a truncated record
+    bool IsComplete() const { return NumRead == NumPolylines && !bTruncated; }
+
+//Attributes
+private:
+    const unsigned char* pData = nullptr;
+    size_t Size = 0;
+    size_t Cursor = 0;
+    ///Start of the pages that are still needed
+    size_t Released = 0;
+    uint64_t NumPolylines = 0;
+    uint64_t NumRead = 0;
+    bool bTruncated = false;
+#ifdef _WIN32
+    void* hFile = nullptr;
+    void* hMapping = nullptr;
+#else
+    int FileDescriptor = -1;
+#endif
+};
+
+/** \class PolylineFileWriter
+    \brief Writes polylines in the format of MappedPolylineFile, one at a time.
+*/
+class IVW_MODULE_LABSUBDIVISION_API PolylineFileWriter
+{
+//Methods
+public:
+    bool Open(const std::string& Path);
+
+    /** Writes one polyline. Returns false without writing anything if the polyline has
+        more vertices than the 32-bit count of the format can hold.
+    */
+    bool Append(const vec3* pVertices, size_t NumVertices);
+
+    ///Writes the number of polylines into the header and closes the file
+    bool Close();
+
+//Attributes
+private:
+    std::ofstream File;
+    uint64_t NumPolylines = 0;
+};
+
+/*  Subdivides all polylines of a polyline file into another one, with constant memory.
+
+    The input is mapped and processed in chunks of about MaxChunkVertices vertices. Every
+    chunk is transformed with the world matrix, subdivided in parallel, and appended to
+    the output before the next chunk is read. Returns false if a file cannot be opened or
+    written, if both paths name the same file, or if the input is truncated.
+*/
+IVW_MODULE_LABSUBDIVISION_API bool SubdividePolylineFile(
+    const std::string& InPath, const std::string& OutPath, const mat4& Trafo,
+    ChaikinSubdivision::Method SubdivisionMethod, size_t MinNumPoints, float Tolerance,
+    size_t MaxChunkVertices = size_t(1) << 20);
+
+} // namespace
+} // namespace
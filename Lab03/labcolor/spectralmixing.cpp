@@ -0,0 +1,155 @@
+/*********************************************************************
+ *  Author  : Tino Weinkauf
+ *  Init    : Sunday, October 18, 2026 - 00:47:02
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#include <modules/labcolor/spectralmixing.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace inviwo
+{
+namespace kth
+{
+
+namespace
+{
+
+/*  The RGB basis spectra and their pseudo-inverse, computed once.
+
+    The basis are Gaussians around red, green and blue wavelengths, divided by
+    their sum so that they form a partition of unity.
+*/
+struct SpectralBasis
+{
+    //Basis[c][k]: value of basis spectrum c in bin k
+    std::array<SpectralMixer::Spectrum, 3> Basis;
+    //Projection[c][k]: weight of bin k in RGB component c, (B^T B)^-1 B^T
+    std::array<SpectralMixer::Spectrum, 3> Projection;
+
+    SpectralBasis()
+    {
+        const double Center[3] = {610, 545, 450};
+        const double Width[3] = {40, 35, 30};
+        for (size_t k(0); k < SpectralMixer::NumBins; k++)
+        {
+            const double Lambda = 400 + 10 * double(k);
+            double Value[3], Sum(0);
+            for (int c(0); c < 3; c++)
+            {
+                const double d = (Lambda - Center[c]) / Width[c];
+                Value[c] = std::exp(-0.5 * d * d);
+                Sum += Value[c];
+            }
+            for (int c(0); c < 3; c++) Basis[c][k] = float(Value[c] / Sum);
+        }
+
+        //Gram matrix B^T B and its inverse by cofactors
+        double M[3][3];
+        for (int r(0); r < 3; r++)
+        {
+            for (int c(0); c < 3; c++)
+            {
+                M[r][c] = 0;
+                for (size_t k(0); k < SpectralMixer::NumBins; k++) M[r][c] += Basis[r][k] * Basis[c][k];
+            }
+        }
+        double Inv[3][3];
+        for (int r(0); r < 3; r++)
+        {
+            for (int c(0); c < 3; c++)
+            {
+                const int r1 = (c + 1) % 3, r2 = (c + 2) % 3;
+                const int c1 = (r + 1) % 3, c2 = (r + 2) % 3;
+                Inv[r][c] = M[r1][c1] * M[r2][c2] - M[r1][c2] * M[r2][c1];
+            }
+        }
+        const double Det = M[0][0] * Inv[0][0] + M[0][1] * Inv[1][0] + M[0][2] * Inv[2][0];
+
+        for (int r(0); r < 3; r++)
+        {
+            for (size_t k(0); k < SpectralMixer::NumBins; k++)
+            {
+                double Sum(0);
+                for (int c(0); c < 3; c++) Sum += Inv[r][c] * Basis[c][k];
+                Projection[r][k] = float(Sum / Det);
+            }
+        }
+    }
+
+    static const SpectralBasis& Get()
+    {
+        static const SpectralBasis Instance;
+        return Instance;
+    }
+};
+
+} // namespace
+
+SpectralMixer::Spectrum SpectralMixer::ToSpectrum(const vec3& Color)
+{
+    const SpectralBasis& B = SpectralBasis::Get();
+    Spectrum Values;
+    for (size_t k(0); k < NumBins; k++)
+    {
+        Values[k] = Color.r * B.Basis[0][k] + Color.g * B.Basis[1][k] + Color.b * B.Basis[2][k];
+    }
+    return Values;
+}
+
+vec3 SpectralMixer::ToRGB(const Spectrum& Values)
+{
+    const SpectralBasis& B = SpectralBasis::Get();
+    vec3 Color(0);
+    for (size_t k(0); k < NumBins; k++)
+    {
+        Color.r += B.Projection[0][k] * Values[k];
+        Color.g += B.Projection[1][k] * Values[k];
+        Color.b += B.Projection[2][k] * Values[k];
+    }
+    return glm::clamp(Color, 0.0f, 1.0f);
+}
+
+void SpectralMixer::Update(const std::vector<vec3>& Colors, Mode MixingMode)
+{
+    ivwAssert(Colors.size() <= MaxNumColors, "Too many colors for spectral mixing.");
+    if (!Mixes.empty() && MixingMode == LastMode && Colors == LastColors) return;
+    LastColors = Colors;
+    LastMode = MixingMode;
+
+    NumColors = std::min(Colors.size(), MaxNumColors);
+    const size_t NumSubsets = size_t(1) << NumColors;
+
+    std::vector<Spectrum> Inputs(NumColors);
+    for (size_t i(0); i < NumColors; i++) Inputs[i] = ToSpectrum(Colors[i]);
+
+    //Every subset is its lowest color mixed with the subset of the remaining colors,
+    //which has a smaller index and is done already.
+    std::vector<Spectrum> Spectra(NumSubsets);
+    Spectra[0].fill(MixingMode == Mode::Subtractive ? 1.0f : 0.0f);
+    Mixes.resize(NumSubsets);
+    Mixes[0] = ToRGB(Spectra[0]);
+    for (size_t Subset(1); Subset < NumSubsets; Subset++)
+    {
+        size_t Lowest(0);
+        while (!(Subset & (size_t(1) << Lowest))) Lowest++;
+        const Spectrum& Rest = Spectra[Subset & (Subset - 1)];
+        const Spectrum& Added = Inputs[Lowest];
+
+        Spectrum& Mixed = Spectra[Subset];
+        for (size_t k(0); k < NumBins; k++)
+        {
+            Mixed[k] = (MixingMode == Mode::Subtractive) ? Rest[k] * Added[k] : Rest[k] + Added[k];
+        }
+        Mixes[Subset] = ToRGB(Mixed);
+    }
+}
+
+} // namespace
+} // namespace
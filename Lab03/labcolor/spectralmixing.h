@@ -0,0 +1,93 @@
+/*********************************************************************
+ *  Author  : Tino Weinkauf
+ *  Init    : Sunday, October 18, 2026 - 00:47:02
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#pragma once
+
+#include <modules/labcolor/labcolormoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <array>
+#include <vector>
+
+namespace inviwo
+{
+namespace kth
+{
+
+/** \class SpectralMixer
+    \brief Mixes any number of colors through a sampled spectral representation.
+
+    An RGB color in [0, 1] becomes a reflectance spectrum with NumBins samples
+    between 400 and 700 nm as a combination of three smooth basis spectra that sum
+    to one everywhere: black is zero, white is one in every bin. Spectra are turned
+    back into RGB with the pseudo-inverse of this basis.
+
+    Subtractive mixing multiplies the reflectances bin by bin, as light passing
+    through several inks; additive mixing adds the spectra, as overlapping lights.
+
+    All 2^N combinations of N input colors are mixed at once, each from a smaller
+    combination and one more color, so a change of the inputs costs 2^N spectral
+    products instead of a mix per pixel.
+
+    @author Tino Weinkauf
+*/
+class IVW_MODULE_LABCOLOR_API SpectralMixer
+{
+//Types
+public:
+    ///Samples at 400, 410, ..., 700 nm
+    static constexpr size_t NumBins = 31;
+    using Spectrum = std::array<float, NumBins>;
+
+    ///The 2^N mixes grow fast; 16 colors are already 65536 spectra
+    static constexpr size_t MaxNumColors = 16;
+
+    enum class Mode
+    {
+        Additive,
+        Subtractive
+    };
+
+//Methods
+public:
+    ///Reflectance spectrum of an RGB color in [0, 1]
+    static Spectrum ToSpectrum(const vec3& Color);
+
+    ///RGB color of a spectrum, clamped to [0, 1]
+    static vec3 ToRGB(const Spectrum& Values);
+
+    /** Mixes all combinations of the given colors.
+        Afterwards, GetMix(Subset) is the mix of the colors whose bits are set in Subset.
+
+        Nothing is recomputed if the colors and the mode are those of the last update.
+        Only the first MaxNumColors colors are used.
+    */
+    void Update(const std::vector<vec3>& Colors, Mode MixingMode);
+
+    ///Number of colors of the last update
+    size_t GetNumColors() const { return NumColors; }
+
+    /** Mix of the colors with bit i of Subset set for color i. The empty subset is the
+        neutral element: white for subtractive and black for additive mixing.
+    */
+    const vec3& GetMix(size_t Subset) const { return Mixes[Subset]; }
+
+//Attributes
+private:
+    size_t NumColors = 0;
+    std::vector<vec3> Mixes;
+
+    ///Inputs of the last update
+    std::vector<vec3> LastColors;
+    Mode LastMode = Mode::Additive;
+};
+
+} // namespace
+} // namespace
@@ -0,0 +1,56 @@
+/*********************************************************************
+ *  Author  : Tino Weinkauf
+ *  Init    : Saturday, October 17, 2026 - 20:41:09
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#include <modules/labcolor/swatchlut.h>
+#include <modules/labcolor/parallelrows.h>
+
+namespace inviwo
+{
+namespace kth
+{
+
+bool SwatchLUT::Update(const vec3& ColorA, const vec3& ColorB, const size2_t& BBoxMin,
+                       const size2_t& BBoxMax, bool VariesInY_, const Generator& Generate)
+{
+    const size2_t NewSize = BBoxMax - BBoxMin + size2_t(1);
+    if (!Colors.empty() && ColorA == KeyColorA && ColorB == KeyColorB && BBoxMin == Min &&
+        NewSize == Size && VariesInY_ == VariesInY)
+    {
+        return false;
+    }
+
+    KeyColorA = ColorA;
+    KeyColorB = ColorB;
+    Min = BBoxMin;
+    Size = NewSize;
+    VariesInY = VariesInY_;
+
+    // Same parameterization as the per-pixel evaluation: t = (pixel - BBoxMin) / (BBoxMax - BBoxMin)
+    const vec2 Extent(BBoxMax - BBoxMin);
+    const size_t NumRows = VariesInY ? Size.y : 1;
+    Colors.resize(NumRows * Size.x);
+    ForEachRowBand(NumRows, Size.x, [&](size_t FirstRow, size_t EndRow)
+    {
+        // One batch per row of the table
+        std::vector<vec2> t(Size.x);
+        for (size_t r(FirstRow); r < EndRow; r++)
+        {
+            for (size_t c(0); c < Size.x; c++)
+            {
+                t[c] = vec2(size2_t(c, r)) / Extent;
+            }
+            Generate(t.data(), Size.x, Colors.data() + r * Size.x);
+        }
+    });
+    return true;
+}
+
+} // namespace
+} // namespace
@@ -0,0 +1,76 @@
+/*********************************************************************
+ *  Author  : Tino Weinkauf
+ *  Init    : Saturday, October 17, 2026 - 20:41:09
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#pragma once
+
+#include <modules/labcolor/labcolormoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <functional>
+#include <vector>
+
+namespace inviwo
+{
+namespace kth
+{
+
+/** \class SwatchLUT
+    \brief Precomputed output colors of one interpolation swatch.
+
+    The table covers the bounding box of the swatch. Swatches that only vary along x
+    keep a single row that is shared by all rows of the box; the others keep one color
+    per pixel of the box.
+
+    The table is rebuilt only if the primary colors or the bounding box change.
+
+    @author Tino Weinkauf
+*/
+class IVW_MODULE_LABCOLOR_API SwatchLUT
+{
+//Types
+public:
+    ///Writes the output colors for N interpolation parameters t in [0, 1]^2
+    using Generator = std::function<void(const vec2* t, size_t N, glm::u8vec3* pOut)>;
+
+//Methods
+public:
+    /** Rebuilds the table if any of the arguments differ from the last build.
+        Returns whether the table was rebuilt.
+    */
+    bool Update(const vec3& ColorA, const vec3& ColorB, const size2_t& BBoxMin,
+                const size2_t& BBoxMax, bool VariesInY, const Generator& Generate);
+
+    ///Forces a rebuild on the next update
+    void Invalidate() { Colors.clear(); }
+
+    ///Whether pixel (i, j) is inside the bounding box of the table
+    bool Contains(size_t i, size_t j) const
+    {
+        return !Colors.empty() && i - Min.x < Size.x && j - Min.y < Size.y;
+    }
+
+    ///Color of pixel (i, j), which needs to be inside the bounding box
+    const glm::u8vec3* At(size_t i, size_t j) const
+    {
+        return Colors.data() + (VariesInY ? (j - Min.y) * Size.x : 0) + (i - Min.x);
+    }
+
+//Attributes
+private:
+    vec3 KeyColorA{-1};
+    vec3 KeyColorB{-1};
+    size2_t Min{0};
+    size2_t Size{0};
+    bool VariesInY = false;
+    std::vector<glm::u8vec3> Colors;
+};
+
+} // namespace
+} // namespace
@@ -0,0 +1,100 @@
+/*********************************************************************
+ *  Author  : Tino Weinkauf
+ *  Init    : Saturday, October 17, 2026 - 21:17:44
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#include <modules/labcolor/templatemask.h>
+#include <modules/labcolor/parallelrows.h>
+
+#include <algorithm>
+#include <mutex>
+
+namespace inviwo
+{
+namespace kth
+{
+
+void TemplateMask::Scan(const size2_t& Resolution, const glm::u8vec3* pRaw)
+{
+    // Every band of rows collects its spans in row order; the bands are stitched afterwards.
+    struct Band
+    {
+        size_t FirstRow;
+        std::vector<std::pair<unsigned char, Span>> Spans;
+    };
+    std::vector<Band> Bands;
+    std::mutex BandsMutex;
+
+    ForEachRowBand(Resolution.y, Resolution.x, [&](size_t FirstRow, size_t EndRow)
+    {
+        Band LocalBand{FirstRow, {}};
+        for (size_t j(FirstRow); j < EndRow; j++)
+        {
+            const glm::u8vec3* pRow = pRaw + j * Resolution.x;
+            for (size_t i(0); i < Resolution.x;)
+            {
+                if (!IsTemplatePixel(pRow[i]))
+                {
+                    i++;
+                    continue;
+                }
+                size_t End(i + 1);
+                while (End < Resolution.x && pRow[End] == pRow[i]) End++;
+                LocalBand.Spans.emplace_back(
+                    pRow[i].r, Span{uint32_t(j), uint32_t(i), uint32_t(End)});
+                i = End;
+            }
+        }
+        std::lock_guard<std::mutex> Lock(BandsMutex);
+        Bands.push_back(std::move(LocalBand));
+    });
+    std::sort(Bands.begin(), Bands.end(),
+              [](const Band& A, const Band& B) { return A.FirstRow < B.FirstRow; });
+
+    for (auto& MarkerSpans : Spans) MarkerSpans.clear();
+    for (const Band& CurrentBand : Bands)
+    {
+        for (const auto& MarkerSpan : CurrentBand.Spans)
+        {
+            Spans[MarkerSpan.first].push_back(MarkerSpan.second);
+        }
+    }
+
+    Markers.clear();
+    for (int Marker(0); Marker < 256; Marker++)
+    {
+        const std::vector<Span>& MarkerSpans = Spans[Marker];
+        if (MarkerSpans.empty()) continue;
+        Markers.push_back(static_cast<unsigned char>(Marker));
+
+        // Spans are sorted by row, so only the x-range needs a pass.
+        auto& BBox = BBoxes[Marker];
+        BBox.first = size2_t(MarkerSpans.front().First, MarkerSpans.front().Row);
+        BBox.second = size2_t(MarkerSpans.front().End - 1, MarkerSpans.back().Row);
+        for (const Span& CurrentSpan : MarkerSpans)
+        {
+            BBox.first.x = std::min(BBox.first.x, size_t(CurrentSpan.First));
+            BBox.second.x = std::max(BBox.second.x, size_t(CurrentSpan.End - 1));
+        }
+    }
+}
+
+std::pair<const TemplateMask::Span*, const TemplateMask::Span*>
+TemplateMask::GetSpans(unsigned char Marker, size_t FirstRow, size_t EndRow) const
+{
+    const std::vector<Span>& MarkerSpans = Spans[Marker];
+    auto RowLess = [](const Span& A, size_t Row) { return A.Row < Row; };
+    const auto itFirst =
+        std::lower_bound(MarkerSpans.begin(), MarkerSpans.end(), FirstRow, RowLess);
+    const auto itEnd = std::lower_bound(itFirst, MarkerSpans.end(), EndRow, RowLess);
+    return {MarkerSpans.data() + (itFirst - MarkerSpans.begin()),
+            MarkerSpans.data() + (itEnd - MarkerSpans.begin())};
+}
+
+} // namespace
+} // namespace
@@ -0,0 +1,77 @@
+/*********************************************************************
+ *  Author  : Tino Weinkauf
+ *  Init    : Saturday, October 17, 2026 - 21:17:44
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#pragma once
+
+#include <modules/labcolor/labcolormoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace inviwo
+{
+namespace kth
+{
+
+/** \class TemplateMask
+    \brief Where the color templates of an image are, as horizontal pixel spans.
+
+    A template pixel is a pure red pixel (g = b = 0) whose red value, the marker,
+    is above 110. For every marker, the mask keeps the maximal runs of its pixels
+    in row order together with their bounding box.
+
+    The mask is built in one scan over the image. As long as the image does not change,
+    recoloring only needs to visit the spans instead of the whole image.
+
+    @author Tino Weinkauf
+*/
+class IVW_MODULE_LABCOLOR_API TemplateMask
+{
+//Types
+public:
+    struct Span
+    {
+        uint32_t Row;
+        uint32_t First;
+        uint32_t End;
+    };
+
+//Methods
+public:
+    static bool IsTemplatePixel(const glm::u8vec3& Pixel)
+    {
+        return Pixel.r > 110 && Pixel.g == 0 && Pixel.b == 0;
+    }
+
+    ///Rebuilds the mask from the given image
+    void Scan(const size2_t& Resolution, const glm::u8vec3* pRaw);
+
+    ///Marker values present in the image, in increasing order
+    const std::vector<unsigned char>& GetMarkers() const { return Markers; }
+
+    ///Bounding box (min, max) of all pixels of a marker present in the image
+    const std::pair<size2_t, size2_t>& GetBBox(unsigned char Marker) const { return BBoxes[Marker]; }
+
+    ///Spans of a marker that lie in the rows [FirstRow, EndRow)
+    std::pair<const Span*, const Span*> GetSpans(unsigned char Marker, size_t FirstRow,
+                                                 size_t EndRow) const;
+
+//Attributes
+private:
+    std::vector<unsigned char> Markers;
+    std::array<std::vector<Span>, 256> Spans;
+    std::array<std::pair<size2_t, size2_t>, 256> BBoxes;
+};
+
+} // namespace
+} // namespace
@@ -0,0 +1,123 @@
+/*********************************************************************
+ *  Author  : Tino Weinkauf
+ *  Init    : Sunday, October 18, 2026 - 00:12:37
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#include <modules/labcolor/templaterecolor.h>
+#include <modules/labcolor/templatemask.h>
+#include <modules/labcolor/parallelrows.h>
+
+#include <algorithm>
+#include <cstdint>
+
+//SSE2 is part of every x86-64 CPU, so this needs no runtime dispatch
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LABCOLOR_RECOLOR_SSE2
+#endif
+
+namespace inviwo
+{
+namespace kth
+{
+
+namespace
+{
+
+#ifdef LABCOLOR_RECOLOR_SSE2
+/*  Bit 3p+1 of the result is set if pixel p of the 16 pixels (48 bytes) at pBlock has
+    g = b = 0; all other bits are zero.
+
+    The 48 bytes are compared with zero, and the byte masks are combined so that the green
+    bit of a pixel survives only if its blue bit, the next one, is set as well.
+*/
+uint64_t PureRedMask16(const glm::u8vec3* pBlock)
+{
+    const unsigned char* pBytes = reinterpret_cast<const unsigned char*>(pBlock);
+    const __m128i Zero = _mm_setzero_si128();
+    const uint64_t IsZero0 = uint64_t(_mm_movemask_epi8(_mm_cmpeq_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pBytes)), Zero)));
+    const uint64_t IsZero1 = uint64_t(_mm_movemask_epi8(_mm_cmpeq_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pBytes + 16)), Zero)));
+    const uint64_t IsZero2 = uint64_t(_mm_movemask_epi8(_mm_cmpeq_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pBytes + 32)), Zero)));
+    const uint64_t IsZero = IsZero0 | (IsZero1 << 16) | (IsZero2 << 32);
+
+    //Bits 1, 4, 7, ..., 46: the green byte of each pixel
+    const uint64_t GreenBits = 0x492492492492ull;
+    return IsZero & (IsZero >> 1) & GreenBits;
+}
+#endif
+
+} // namespace
+
+void TemplateRecolor::RecolorRow(glm::u8vec3* pRow, size_t N) const
+{
+    // Selects between the pixel and its palette color with a byte mask instead of a branch,
+    // since template and ordinary pixels alternate unpredictably along their borders
+    const auto Recolor = [this](glm::u8vec3& Pixel)
+    {
+        const unsigned char Keep = ((Pixel.g | Pixel.b) == 0 && Active[Pixel.r]) ? 0 : 0xFF;
+        const glm::u8vec3& Color = Palette[Pixel.r];
+        Pixel.r = (Pixel.r & Keep) | (Color.r & ~Keep);
+        Pixel.g = (Pixel.g & Keep) | (Color.g & ~Keep);
+        Pixel.b = (Pixel.b & Keep) | (Color.b & ~Keep);
+    };
+
+    size_t i(0);
+#ifdef LABCOLOR_RECOLOR_SSE2
+    for (; i + 16 <= N; i += 16)
+    {
+        // Most blocks of a poster contain no pure red pixel at all
+        for (uint64_t Mask = PureRedMask16(pRow + i); Mask; Mask &= Mask - 1)
+        {
+            int Bit(0);
+            while (!(Mask & (uint64_t(1) << Bit))) Bit++;
+            Recolor(pRow[i + Bit / 3]);
+        }
+    }
+#endif
+    for (; i < N; i++)
+    {
+        Recolor(pRow[i]);
+    }
+}
+
+void TemplateRecolor::Apply(const size2_t& Resolution, glm::u8vec3* pRaw) const
+{
+    ForEachRowBand(Resolution.y, Resolution.x, [&](size_t FirstRow, size_t EndRow)
+    {
+        for (size_t j(FirstRow); j < EndRow; j++)
+        {
+            RecolorRow(pRaw + j * Resolution.x, Resolution.x);
+        }
+    });
+}
+
+void TemplateRecolor::Apply(const TemplateMask& Mask, const size2_t& Resolution,
+                            glm::u8vec3* pRaw) const
+{
+    ForEachRowBand(Resolution.y, Resolution.x, [&](size_t FirstRow, size_t EndRow)
+    {
+        for (const unsigned char Marker : Mask.GetMarkers())
+        {
+            if (!Active[Marker]) continue;
+
+            // Spans consist of this marker only, so they are filled without a lookup
+            const auto Spans = Mask.GetSpans(Marker, FirstRow, EndRow);
+            for (const TemplateMask::Span* pSpan = Spans.first; pSpan != Spans.second; pSpan++)
+            {
+                glm::u8vec3* pRow = pRaw + pSpan->Row * Resolution.x;
+                std::fill(pRow + pSpan->First, pRow + pSpan->End, Palette[Marker]);
+            }
+        }
+    });
+}
+
+} // namespace
+} // namespace
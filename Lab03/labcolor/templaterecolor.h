@@ -0,0 +1,80 @@
+/*********************************************************************
+ *  Author  : Tino Weinkauf
+ *  Init    : Sunday, October 18, 2026 - 00:12:37
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#pragma once
+
+#include <modules/labcolor/labcolormoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <array>
+
+namespace inviwo
+{
+namespace kth
+{
+
+class TemplateMask;
+
+/** \class TemplateRecolor
+    \brief Replaces the color template of an image with a palette of output colors.
+
+    The palette maps a marker value, the red channel of a pure red template pixel
+    (g = b = 0), to the output color of that pixel. Markers without a palette entry
+    are left alone.
+
+    Recoloring runs row by row in parallel bands. Blocks of 16 pixels without any pure
+    red pixel are skipped with one SIMD test; the others are looked up in the palette.
+
+    @author Tino Weinkauf
+*/
+class IVW_MODULE_LABCOLOR_API TemplateRecolor
+{
+//Construction / Deconstruction
+public:
+    TemplateRecolor() { Clear(); }
+
+//Methods
+public:
+    ///Removes all palette entries
+    void Clear()
+    {
+        Palette.fill(glm::u8vec3(0));
+        Active.fill(0);
+    }
+
+    ///Pixels of the given marker will be replaced by Color
+    void SetColor(unsigned char Marker, const glm::u8vec3& Color)
+    {
+        Palette[Marker] = Color;
+        Active[Marker] = 1;
+    }
+
+    ///Whether the given marker has a palette entry
+    bool HasColor(unsigned char Marker) const { return Active[Marker] != 0; }
+
+    ///Recolors N pixels of one row in place
+    void RecolorRow(glm::u8vec3* pRow, size_t N) const;
+
+    ///Recolors the whole image in place
+    void Apply(const size2_t& Resolution, glm::u8vec3* pRaw) const;
+
+    /** Recolors only the template spans of the image in place. The mask needs to be
+        scanned from this image, and only knows about markers above 110.
+    */
+    void Apply(const TemplateMask& Mask, const size2_t& Resolution, glm::u8vec3* pRaw) const;
+
+//Attributes
+private:
+    std::array<glm::u8vec3, 256> Palette;
+    std::array<unsigned char, 256> Active;
+};
+
+} // namespace
+} // namespace
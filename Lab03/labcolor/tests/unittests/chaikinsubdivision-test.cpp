@@ -0,0 +1,190 @@
+/*********************************************************************
+ *  Author  : Tino Weinkauf
+ *  Init    : Sunday, October 18, 2026 - 14:51:08
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/labsubdivision/chaikinsubdivision.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace inviwo
+{
+namespace kth
+{
+
+namespace
+{
+
+/*  Random closed polygons of 3 to 30 vertices, without a repeated end point.
+*/
+std::vector<std::vector<vec3>> RandomPolygons(const size_t NumPolygons)
+{
+    std::mt19937 Rng(13);
+    std::uniform_int_distribution<size_t> NumVertices(3, 30);
+    std::uniform_real_distribution<float> Coordinate(-1, 1);
+    std::vector<std::vector<vec3>> Polygons(NumPolygons);
+    for (std::vector<vec3>& Polygon : Polygons)
+    {
+        Polygon.resize(NumVertices(Rng));
+        for (vec3& Vertex : Polygon)
+        {
+            Vertex = vec3(Coordinate(Rng), Coordinate(Rng), Coordinate(Rng));
+        }
+    }
+    return Polygons;
+}
+
+/*  Corner cutting as in the textbook: a new polygon for every level.
+*/
+std::vector<vec3> ReferenceCornerCutting(std::vector<vec3> Polygon, const size_t MinNumPoints)
+{
+    while (!Polygon.empty() && Polygon.size() < MinNumPoints)
+    {
+        std::vector<vec3> Refined;
+        for (size_t i(0); i < Polygon.size(); i++)
+        {
+            const vec3& P = Polygon[i];
+            const vec3& Q = Polygon[(i + 1) % Polygon.size()];
+            Refined.push_back(0.75f * P + 0.25f * Q);
+            Refined.push_back(0.25f * P + 0.75f * Q);
+        }
+        Polygon.swap(Refined);
+    }
+    return Polygon;
+}
+
+/*  Distance of Point to the line segment from A to B.
+*/
+float SegmentDistance(const vec3& Point, const vec3& A, const vec3& B)
+{
+    const vec3 AB = B - A;
+    const float Length2 = glm::dot(AB, AB);
+    const float t =
+        (Length2 > 0) ? glm::clamp(glm::dot(Point - A, AB) / Length2, 0.0f, 1.0f) : 0.0f;
+    return glm::length(Point - (A + t * AB));
+}
+
+/*  Point at parameter t of segment i of the limit curve, in double precision.
+*/
+vec3 LimitPoint(const std::vector<vec3>& Polygon, const size_t i, const double t)
+{
+    const size_t N = Polygon.size();
+    const dvec3 P0(Polygon[i]), P1(Polygon[(i + 1) % N]), P2(Polygon[(i + 2) % N]);
+    return vec3(0.5 * (1 - t) * (1 - t) * P0 + (0.5 + t - t * t) * P1 + 0.5 * t * t * P2);
+}
+
+} // namespace
+
+TEST(ChaikinSubdivision, SubdivideMatchesReferenceCornerCutting)
+{
+    ChaikinSubdivision Subdivision;
+    std::vector<vec3> Curve;
+    for (const std::vector<vec3>& Polygon : RandomPolygons(50))
+    {
+        //No level, one level, and several, reusing the same instance
+        for (const size_t MinNumPoints : {size_t(0), Polygon.size(), Polygon.size() + 1,
+                                          size_t(100), size_t(1000)})
+        {
+            Subdivision.Subdivide(Polygon, MinNumPoints, Curve);
+            const std::vector<vec3> Expected = ReferenceCornerCutting(Polygon, MinNumPoints);
+            ASSERT_EQ(Curve.size(), Expected.size()) << "MinNumPoints = " << MinNumPoints;
+            for (size_t i(0); i < Curve.size(); i++)
+            {
+                EXPECT_EQ(Curve[i], Expected[i]) << "MinNumPoints = " << MinNumPoints
+                                                 << ", i = " << i;
+            }
+        }
+    }
+}
+
+/*  The midpoints of the legs of every level lie on the limit curve: the midpoint of leg j
+    of level L is the limit curve at j / 2^L segments, which is sample j when the curve is
+    sampled with as many points as the level has.
+*/
+TEST(ChaikinSubdivision, LimitCurveMatchesDeepSubdivision)
+{
+    constexpr size_t Levels = 6;
+    ChaikinSubdivision Subdivision;
+    std::vector<vec3> Subdivided, Curve;
+    for (const std::vector<vec3>& Polygon : RandomPolygons(50))
+    {
+        const size_t NumPoints = Polygon.size() << Levels;
+        Subdivision.Subdivide(Polygon, NumPoints, Subdivided);
+        ASSERT_EQ(Subdivided.size(), NumPoints);
+        ChaikinSubdivision::EvaluateLimitCurve(Polygon, NumPoints, Curve);
+        ASSERT_EQ(Curve.size(), NumPoints);
+
+        float MaxError(0);
+        for (size_t j(0); j < NumPoints; j++)
+        {
+            const vec3 Midpoint = 0.5f * (Subdivided[j] + Subdivided[(j + 1) % NumPoints]);
+            MaxError = std::max(MaxError, glm::length(Curve[j] - Midpoint));
+        }
+        EXPECT_LT(MaxError, 1e-5f);
+    }
+}
+
+/*  Every chord of the adaptive sampling, including the one into the next segment, stays
+    within the tolerance of the limit curve it replaces, and the minimum number of points
+    is met.
+*/
+TEST(ChaikinSubdivision, AdaptiveLimitCurveMeetsTolerance)
+{
+    constexpr int NumTestsPerChord = 16;
+    std::vector<uint32_t> NumPointsPerSegment;
+    std::vector<vec3> Curve;
+    for (const std::vector<vec3>& Polygon : RandomPolygons(50))
+    {
+        const size_t N = Polygon.size();
+        for (const float Tolerance : {0.1f, 0.01f, 0.001f})
+        {
+            for (const size_t MinNumPoints : {size_t(0), 4 * N, size_t(2000)})
+            {
+                bool bCapped(true);
+                const size_t NumPoints = ChaikinSubdivision::AdaptiveSegmentCounts(
+                    Polygon, Tolerance, MinNumPoints, NumPointsPerSegment, &bCapped);
+                ASSERT_FALSE(bCapped);
+                EXPECT_GE(NumPoints, MinNumPoints);
+                ChaikinSubdivision::EvaluateLimitCurve(Polygon, NumPointsPerSegment, Curve);
+                ASSERT_EQ(Curve.size(), NumPoints);
+
+                float MaxDeviation(0);
+                size_t First(0);
+                for (size_t i(0); i < N; i++)
+                {
+                    const uint32_t k = NumPointsPerSegment[i];
+                    for (uint32_t j(0); j < k; j++)
+                    {
+                        const vec3& A = Curve[First + j];
+                        const vec3& B = Curve[(First + j + 1) % NumPoints];
+                        for (int s(1); s < NumTestsPerChord; s++)
+                        {
+                            const double t = (j + double(s) / NumTestsPerChord) / k;
+                            MaxDeviation = std::max(
+                                MaxDeviation, SegmentDistance(LimitPoint(Polygon, i, t), A, B));
+                        }
+                    }
+                    First += k;
+                }
+                EXPECT_LE(MaxDeviation, Tolerance * 1.001f + 1e-6f)
+                    << "Tolerance = " << Tolerance << ", MinNumPoints = " << MinNumPoints;
+            }
+        }
+    }
+}
+
+} // namespace
+} // namespace
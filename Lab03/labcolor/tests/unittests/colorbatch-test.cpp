@@ -0,0 +1,212 @@
+/*********************************************************************
+ *  Author  : Tino Weinkauf
+ *  Init    : Saturday, October 17, 2026 - 21:52:06
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/labcolor/colorbatch.h>
+#include <modules/labcolor/cpufeatures.h>
+#include <modules/labcolor/colorspace/src/ColorSpace.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace inviwo
+{
+namespace kth
+{
+
+namespace
+{
+
+//Maximum deviations from ColorSpace, in the units of the target space
+constexpr double HueTolerance = 1e-2;       //degrees
+constexpr double UnitTolerance = 1e-4;      //s, v, c, m, y, k in [0, 1]
+constexpr double RgbTolerance = 1e-2;       //r, g, b in [0, 255]
+constexpr double LabTolerance = 1e-3;
+
+/*  Random RGB colors with the special cases of the HSV and CMYK conversions mixed in:
+    grays, ties between two channels, black and white.
+*/
+struct RgbColors
+{
+    std::vector<float> R, G, B;
+
+    explicit RgbColors(const size_t N)
+        :R(N), G(N), B(N)
+    {
+        std::mt19937 Rng(3);
+        std::uniform_real_distribution<float> U(0, 255);
+        for (size_t i(0); i < N; i++)
+        {
+            R[i] = U(Rng);
+            G[i] = U(Rng);
+            B[i] = U(Rng);
+            switch (i % 5)
+            {
+                case 1: G[i] = B[i] = R[i]; break;
+                case 2: R[i] = std::round(R[i]); B[i] = R[i]; break;
+                case 3: R[i] = G[i] = B[i] = (i % 2) ? 0.0f : 255.0f; break;
+                default: break;
+            }
+        }
+    }
+};
+
+/*  Sizes that run only the scalar tail, and the AVX2 blocks followed by a tail.
+*/
+const size_t Sizes[] = {7, 1003};
+
+/*  The instruction sets of this CPU. Every conversion has to match ColorSpace on each of them.
+*/
+std::vector<CpuFeatures::SimdLevel> SimdLevels()
+{
+    std::vector<CpuFeatures::SimdLevel> Levels;
+    for (const auto Level : {CpuFeatures::SimdLevel::Scalar, CpuFeatures::SimdLevel::AVX2})
+    {
+        if (Level <= CpuFeatures::Supported()) Levels.push_back(Level);
+    }
+    return Levels;
+}
+
+} // namespace
+
+TEST(ColorBatch, RgbToHsvMatchesColorSpace)
+{
+    for (const CpuFeatures::SimdLevel Level : SimdLevels())
+    {
+        CpuFeatures::SetCurrent(Level);
+        SCOPED_TRACE("SIMD level " + std::to_string(int(Level)));
+        for (const size_t N : Sizes)
+        {
+            const RgbColors In(N);
+            std::vector<float> H(N), S(N), V(N);
+            ColorBatch::RgbToHsv(N, In.R.data(), In.G.data(), In.B.data(), H.data(), S.data(), V.data());
+            for (size_t i(0); i < N; i++)
+            {
+                ColorSpace::Rgb Color(In.R[i], In.G[i], In.B[i]);
+                ColorSpace::Hsv Expected;
+                Color.To<ColorSpace::Hsv>(&Expected);
+                const double dHue = std::abs(Expected.h - H[i]);
+                EXPECT_LE(std::min(dHue, 360 - dHue), HueTolerance) << "N = " << N << ", i = " << i;
+                EXPECT_NEAR(S[i], Expected.s, UnitTolerance) << "N = " << N << ", i = " << i;
+                EXPECT_NEAR(V[i], Expected.v, UnitTolerance) << "N = " << N << ", i = " << i;
+            }
+        }
+    }
+    CpuFeatures::SetCurrent(CpuFeatures::Supported());
+}
+
+TEST(ColorBatch, HsvToRgbMatchesColorSpace)
+{
+    for (const CpuFeatures::SimdLevel Level : SimdLevels())
+    {
+        CpuFeatures::SetCurrent(Level);
+        SCOPED_TRACE("SIMD level " + std::to_string(int(Level)));
+        std::mt19937 Rng(5);
+        std::uniform_real_distribution<float> U(0, 1);
+        for (const size_t N : Sizes)
+        {
+            //Includes hues beyond 360 and saturations and values beyond 1, which the
+            //interpolation swatches produce
+            std::vector<float> H(N), S(N), V(N), R(N), G(N), B(N);
+            for (size_t i(0); i < N; i++)
+            {
+                H[i] = U(Rng) * 1800;
+                S[i] = U(Rng) * 2;
+                V[i] = U(Rng) * 2;
+            }
+            ColorBatch::HsvToRgb(N, H.data(), S.data(), V.data(), R.data(), G.data(), B.data());
+            for (size_t i(0); i < N; i++)
+            {
+                ColorSpace::Hsv Color(H[i], S[i], V[i]);
+                ColorSpace::Rgb Expected;
+                Color.ToRgb(&Expected);
+                EXPECT_NEAR(R[i], Expected.r, RgbTolerance) << "N = " << N << ", i = " << i;
+                EXPECT_NEAR(G[i], Expected.g, RgbTolerance) << "N = " << N << ", i = " << i;
+                EXPECT_NEAR(B[i], Expected.b, RgbTolerance) << "N = " << N << ", i = " << i;
+            }
+        }
+    }
+    CpuFeatures::SetCurrent(CpuFeatures::Supported());
+}
+
+TEST(ColorBatch, CmykMatchesColorSpace)
+{
+    for (const CpuFeatures::SimdLevel Level : SimdLevels())
+    {
+        CpuFeatures::SetCurrent(Level);
+        SCOPED_TRACE("SIMD level " + std::to_string(int(Level)));
+        for (const size_t N : Sizes)
+        {
+            const RgbColors In(N);
+            std::vector<float> C(N), M(N), Y(N), K(N), R(N), G(N), B(N);
+            ColorBatch::RgbToCmyk(N, In.R.data(), In.G.data(), In.B.data(), C.data(), M.data(), Y.data(), K.data());
+            ColorBatch::CmykToRgb(N, C.data(), M.data(), Y.data(), K.data(), R.data(), G.data(), B.data());
+            for (size_t i(0); i < N; i++)
+            {
+                ColorSpace::Rgb Color(In.R[i], In.G[i], In.B[i]);
+                ColorSpace::Cmyk Expected;
+                Color.To<ColorSpace::Cmyk>(&Expected);
+                EXPECT_NEAR(C[i], Expected.c, UnitTolerance) << "N = " << N << ", i = " << i;
+                EXPECT_NEAR(M[i], Expected.m, UnitTolerance) << "N = " << N << ", i = " << i;
+                EXPECT_NEAR(Y[i], Expected.y, UnitTolerance) << "N = " << N << ", i = " << i;
+                EXPECT_NEAR(K[i], Expected.k, UnitTolerance) << "N = " << N << ", i = " << i;
+
+                ColorSpace::Rgb Back;
+                ColorSpace::Cmyk(C[i], M[i], Y[i], K[i]).ToRgb(&Back);
+                EXPECT_NEAR(R[i], Back.r, RgbTolerance) << "N = " << N << ", i = " << i;
+                EXPECT_NEAR(G[i], Back.g, RgbTolerance) << "N = " << N << ", i = " << i;
+                EXPECT_NEAR(B[i], Back.b, RgbTolerance) << "N = " << N << ", i = " << i;
+            }
+        }
+    }
+    CpuFeatures::SetCurrent(CpuFeatures::Supported());
+}
+
+TEST(ColorBatch, LabMatchesColorSpace)
+{
+    for (const CpuFeatures::SimdLevel Level : SimdLevels())
+    {
+        CpuFeatures::SetCurrent(Level);
+        SCOPED_TRACE("SIMD level " + std::to_string(int(Level)));
+        for (const size_t N : Sizes)
+        {
+            const RgbColors In(N);
+            std::vector<float> L(N), A(N), LabB(N), R(N), G(N), B(N);
+            ColorBatch::RgbToLab(N, In.R.data(), In.G.data(), In.B.data(), L.data(), A.data(), LabB.data());
+            ColorBatch::LabToRgb(N, L.data(), A.data(), LabB.data(), R.data(), G.data(), B.data());
+            for (size_t i(0); i < N; i++)
+            {
+                ColorSpace::Rgb Color(In.R[i], In.G[i], In.B[i]);
+                ColorSpace::Lab Expected;
+                Color.To<ColorSpace::Lab>(&Expected);
+                EXPECT_NEAR(L[i], Expected.l, LabTolerance) << "N = " << N << ", i = " << i;
+                EXPECT_NEAR(A[i], Expected.a, LabTolerance) << "N = " << N << ", i = " << i;
+                EXPECT_NEAR(LabB[i], Expected.b, LabTolerance) << "N = " << N << ", i = " << i;
+
+                ColorSpace::Rgb Back;
+                ColorSpace::Lab(L[i], A[i], LabB[i]).ToRgb(&Back);
+                EXPECT_NEAR(R[i], Back.r, RgbTolerance) << "N = " << N << ", i = " << i;
+                EXPECT_NEAR(G[i], Back.g, RgbTolerance) << "N = " << N << ", i = " << i;
+                EXPECT_NEAR(B[i], Back.b, RgbTolerance) << "N = " << N << ", i = " << i;
+            }
+        }
+    }
+    CpuFeatures::SetCurrent(CpuFeatures::Supported());
+}
+
+} // namespace
+} // namespace
@@ -0,0 +1,163 @@
+/*********************************************************************
+ *  Author  : Tino Weinkauf
+ *  Init    : Saturday, October 17, 2026 - 22:38:15
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/labcolor/deltae2000.h>
+#include <modules/labcolor/cpufeatures.h>
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace inviwo
+{
+namespace kth
+{
+
+namespace
+{
+
+struct ReferencePair
+{
+    float L1, A1, B1;
+    float L2, A2, B2;
+    float DeltaE;
+    ///Other admissible result, for pairs whose hues are exactly 180 degrees apart
+    float OnDiscontinuity;
+};
+
+/*  The test data of G. Sharma, W. Wu and E. N. Dalal, "The CIEDE2000 color-difference
+    formula: implementation notes, supplementary test data, and mathematical observations",
+    Color Research and Application 30(1), 2005, Table 1.
+
+    Pairs 10 and 14 have hues exactly 180 degrees apart, where the mean hue jumps. The
+    table resolves them to one side; the rounding of single precision may land on the
+    other side, whose value the neighbouring pairs give.
+*/
+const ReferencePair SharmaPairs[] = {
+    {50.0000f, 2.6772f, -79.7751f, 50.0000f, 0.0000f, -82.7485f, 2.0425f, 0.0f},
+    {50.0000f, 3.1571f, -77.2803f, 50.0000f, 0.0000f, -82.7485f, 2.8615f, 0.0f},
+    {50.0000f, 2.8361f, -74.0200f, 50.0000f, 0.0000f, -82.7485f, 3.4412f, 0.0f},
+    {50.0000f, -1.3802f, -84.2814f, 50.0000f, 0.0000f, -82.7485f, 1.0000f, 0.0f},
+    {50.0000f, -1.1848f, -84.8006f, 50.0000f, 0.0000f, -82.7485f, 1.0000f, 0.0f},
+    {50.0000f, -0.9009f, -85.5211f, 50.0000f, 0.0000f, -82.7485f, 1.0000f, 0.0f},
+    {50.0000f, 0.0000f, 0.0000f, 50.0000f, -1.0000f, 2.0000f, 2.3669f, 0.0f},
+    {50.0000f, -1.0000f, 2.0000f, 50.0000f, 0.0000f, 0.0000f, 2.3669f, 0.0f},
+    {50.0000f, 2.4900f, -0.0010f, 50.0000f, -2.4900f, 0.0009f, 7.1792f, 0.0f},
+    {50.0000f, 2.4900f, -0.0010f, 50.0000f, -2.4900f, 0.0010f, 7.1792f, 7.2195f},
+    {50.0000f, 2.4900f, -0.0010f, 50.0000f, -2.4900f, 0.0011f, 7.2195f, 0.0f},
+    {50.0000f, 2.4900f, -0.0010f, 50.0000f, -2.4900f, 0.0012f, 7.2195f, 0.0f},
+    {50.0000f, -0.0010f, 2.4900f, 50.0000f, 0.0009f, -2.4900f, 4.8045f, 0.0f},
+    {50.0000f, -0.0010f, 2.4900f, 50.0000f, 0.0010f, -2.4900f, 4.8045f, 4.7461f},
+    {50.0000f, -0.0010f, 2.4900f, 50.0000f, 0.0011f, -2.4900f, 4.7461f, 0.0f},
+    {50.0000f, 2.5000f, 0.0000f, 50.0000f, 0.0000f, -2.5000f, 4.3065f, 0.0f},
+    {50.0000f, 2.5000f, 0.0000f, 73.0000f, 25.0000f, -18.0000f, 27.1492f, 0.0f},
+    {50.0000f, 2.5000f, 0.0000f, 61.0000f, -5.0000f, 29.0000f, 22.8977f, 0.0f},
+    {50.0000f, 2.5000f, 0.0000f, 56.0000f, -27.0000f, -3.0000f, 31.9030f, 0.0f},
+    {50.0000f, 2.5000f, 0.0000f, 58.0000f, 24.0000f, 15.0000f, 19.4535f, 0.0f},
+    {50.0000f, 2.5000f, 0.0000f, 50.0000f, 3.1736f, 0.5854f, 1.0000f, 0.0f},
+    {50.0000f, 2.5000f, 0.0000f, 50.0000f, 3.2972f, 0.0000f, 1.0000f, 0.0f},
+    {50.0000f, 2.5000f, 0.0000f, 50.0000f, 1.8634f, 0.5757f, 1.0000f, 0.0f},
+    {50.0000f, 2.5000f, 0.0000f, 50.0000f, 3.2592f, 0.3350f, 1.0000f, 0.0f},
+    {60.2574f, -34.0099f, 36.2677f, 60.4626f, -34.1751f, 39.4387f, 1.2644f, 0.0f},
+    {63.0109f, -31.0961f, -5.8663f, 62.8187f, -29.7946f, -4.0864f, 1.2630f, 0.0f},
+    {61.2901f, 3.7196f, -5.3901f, 61.4292f, 2.2480f, -4.9620f, 1.8731f, 0.0f},
+    {35.0831f, -44.1164f, 3.7933f, 35.0232f, -40.0716f, 1.5901f, 1.8645f, 0.0f},
+    {22.7233f, 20.0904f, -46.6940f, 23.0331f, 14.9730f, -42.5619f, 2.0373f, 0.0f},
+    {36.4612f, 47.8580f, 18.3852f, 36.2715f, 50.5065f, 21.2231f, 1.4146f, 0.0f},
+    {90.8027f, -2.0831f, 1.4410f, 91.1528f, -1.6435f, 0.0447f, 1.4441f, 0.0f},
+    {90.9257f, -0.5406f, -0.9208f, 88.6381f, -0.8985f, -0.7239f, 1.5381f, 0.0f},
+    {6.7747f, -0.2908f, -2.4247f, 5.8714f, -0.0985f, -2.2286f, 0.6377f, 0.0f},
+    {2.0776f, 0.0795f, -1.1350f, 0.9033f, -0.0636f, -0.5514f, 0.9082f, 0.0f},
+};
+
+//The table has four decimals; single precision adds a little on top
+constexpr float SharmaTolerance = 2e-4f;
+
+} // namespace
+
+TEST(DeltaE2000, MatchesSharmaTestData)
+{
+    const auto Matches = [](const ReferencePair& Pair, float DeltaE)
+    {
+        return std::abs(DeltaE - Pair.DeltaE) <= SharmaTolerance ||
+               (Pair.OnDiscontinuity > 0 &&
+                std::abs(DeltaE - Pair.OnDiscontinuity) <= SharmaTolerance);
+    };
+
+    for (const ReferencePair& Pair : SharmaPairs)
+    {
+        //The formula is symmetric, so either color can be the reference
+        float DeltaE;
+        ColorBatch::DeltaE2000(1, &Pair.L1, &Pair.A1, &Pair.B1,
+                               ColorBatch::LabReference(Pair.L2, Pair.A2, Pair.B2), &DeltaE);
+        EXPECT_TRUE(Matches(Pair, DeltaE))
+            << DeltaE << " instead of " << Pair.DeltaE << " for Lab1 (" << Pair.L1 << ", " << Pair.A1 << ", " << Pair.B1 << ")";
+        ColorBatch::DeltaE2000(1, &Pair.L2, &Pair.A2, &Pair.B2,
+                               ColorBatch::LabReference(Pair.L1, Pair.A1, Pair.B1), &DeltaE);
+        EXPECT_TRUE(Matches(Pair, DeltaE))
+            << DeltaE << " instead of " << Pair.DeltaE << " for Lab2 (" << Pair.L2 << ", " << Pair.A2 << ", " << Pair.B2 << ")";
+    }
+}
+
+/*  The bounds only decide colors they are sure about, so the decisions must be exactly
+    those of the full formula.
+*/
+TEST(DeltaE2000, BoundedDecisionsMatchFullFormula)
+{
+    const size_t N = 20000;
+    std::mt19937 Rng(11);
+    std::uniform_real_distribution<float> Lightness(0, 100), Axis(-110, 110);
+    std::vector<float> L(N), A(N), B(N);
+    for (size_t i(0); i < N; i++)
+    {
+        L[i] = Lightness(Rng);
+        A[i] = Axis(Rng);
+        B[i] = Axis(Rng);
+        //Near-gray colors, where the hue is ill-defined
+        if (i % 4 == 0) A[i] *= 1e-3f, B[i] *= 1e-3f;
+    }
+
+    const ColorBatch::LabReference& Black = ColorBatch::LabReference::Black();
+    const ColorBatch::LabReference& White = ColorBatch::LabReference::White();
+    const ColorBatch::LabReference Red(53.24f, 80.09f, 67.20f);
+    std::vector<float> ToBlack(N), ToWhite(N), ToRed(N);
+    ColorBatch::DeltaE2000(N, L.data(), A.data(), B.data(), Black, ToBlack.data());
+    ColorBatch::DeltaE2000(N, L.data(), A.data(), B.data(), White, ToWhite.data());
+    ColorBatch::DeltaE2000(N, L.data(), A.data(), B.data(), Red, ToRed.data());
+
+    //The bounds run eight colors at a time with AVX2, and must be as safe as the scalar ones
+    for (const auto Level : {CpuFeatures::SimdLevel::Scalar, CpuFeatures::SimdLevel::AVX2})
+    {
+        if (Level > CpuFeatures::Supported()) continue;
+        CpuFeatures::SetCurrent(Level);
+        SCOPED_TRACE("SIMD level " + std::to_string(int(Level)));
+
+        std::vector<unsigned char> IsFarther(N), IsWithin(N);
+        ColorBatch::FartherFromFirst(N, L.data(), A.data(), B.data(), Black, White,
+                                     IsFarther.data());
+        ColorBatch::WithinDeltaE2000(N, L.data(), A.data(), B.data(), Red, 40.0f,
+                                     IsWithin.data());
+        for (size_t i(0); i < N; i++)
+        {
+            EXPECT_EQ(IsFarther[i] != 0, ToBlack[i] > ToWhite[i]) << "i = " << i;
+            EXPECT_EQ(IsWithin[i] != 0, ToRed[i] <= 40.0f) << "i = " << i;
+        }
+    }
+    CpuFeatures::SetCurrent(CpuFeatures::Supported());
+}
+
+} // namespace
+} // namespace
@@ -0,0 +1,195 @@
+/*********************************************************************
+ *  Author  : Tino Weinkauf
+ *  Init    : Sunday, October 18, 2026 - 00:12:40
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/labsubdivision/polylinestream.h>
+
+#include <filesystem>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace inviwo
+{
+namespace kth
+{
+
+namespace
+{
+
+/*  Random closed polylines of 3 to 40 vertices, without a repeated end point.
+*/
+std::vector<std::vector<vec3>> RandomPolylines(const size_t NumPolylines)
+{
+    std::mt19937 Rng(7);
+    std::uniform_int_distribution<size_t> NumVertices(3, 40);
+    std::uniform_real_distribution<float> Coordinate(-1, 1);
+    std::vector<std::vector<vec3>> Polylines(NumPolylines);
+    for (std::vector<vec3>& Polyline : Polylines)
+    {
+        Polyline.resize(NumVertices(Rng));
+        for (vec3& Vertex : Polyline)
+        {
+            Vertex = vec3(Coordinate(Rng), Coordinate(Rng), Coordinate(Rng));
+        }
+    }
+    return Polylines;
+}
+
+std::string TempPath(const std::string& Name)
+{
+    return (std::filesystem::temp_directory_path() / Name).string();
+}
+
+bool WritePolylines(const std::string& Path, const std::vector<std::vector<vec3>>& Polylines)
+{
+    PolylineFileWriter Writer;
+    if (!Writer.Open(Path)) return false;
+    for (const std::vector<vec3>& Polyline : Polylines)
+    {
+        if (!Writer.Append(Polyline.data(), Polyline.size())) return false;
+    }
+    return Writer.Close();
+}
+
+} // namespace
+
+TEST(PolylineStream, RoundTripMatchesInMemorySubdivision)
+{
+    const std::vector<std::vector<vec3>> Polylines = RandomPolylines(300);
+    const std::string InPath = TempPath("polylinestream-test-in.kply");
+    const std::string OutPath = TempPath("polylinestream-test-out.kply");
+    ASSERT_TRUE(WritePolylines(InPath, Polylines));
+
+    for (const auto SubdivisionMethod :
+         {ChaikinSubdivision::Method::CornerCutting, ChaikinSubdivision::Method::LimitCurve,
+          ChaikinSubdivision::Method::AdaptiveLimitCurve})
+    {
+        //Small chunks, so that the file is read in many of them
+        ASSERT_TRUE(SubdividePolylineFile(InPath, OutPath, mat4(1), SubdivisionMethod, 64,
+                                          0.001f, 100));
+
+        MappedPolylineFile Out;
+        ASSERT_TRUE(Out.Open(OutPath));
+        ASSERT_EQ(Out.GetNumPolylines(), Polylines.size());
+
+        ChaikinSubdivision Subdivision;
+        std::vector<vec3> Expected;
+        std::vector<MappedPolylineFile::Polyline> Chunk;
+        size_t p(0);
+        while (Out.NextChunk(1000, Chunk))
+        {
+            for (const MappedPolylineFile::Polyline& Curve : Chunk)
+            {
+                Subdivision.Subdivide(SubdivisionMethod, Polylines[p], 64, 0.001f, Expected);
+                ASSERT_EQ(Curve.NumVertices, Expected.size()) << "Polyline " << p;
+                for (size_t i(0); i < Expected.size(); i++)
+                {
+                    EXPECT_EQ(Curve.pVertices[i], Expected[i]) << "Polyline " << p << ", vertex " << i;
+                }
+                p++;
+            }
+        }
+        EXPECT_EQ(p, Polylines.size());
+        EXPECT_TRUE(Out.IsComplete());
+    }
+
+    std::filesystem::remove(InPath);
+    std::filesystem::remove(OutPath);
+}
+
+TEST(PolylineStream, ChunksStayWithinMaxVertices)
+{
+    std::vector<std::vector<vec3>> Polylines = RandomPolylines(200);
+    //A polyline larger than a whole chunk
+    Polylines[50].resize(500, vec3(0.5f));
+    const std::string Path = TempPath("polylinestream-test-chunks.kply");
+    ASSERT_TRUE(WritePolylines(Path, Polylines));
+
+    const size_t MaxVertices = 100;
+    MappedPolylineFile In;
+    ASSERT_TRUE(In.Open(Path));
+    std::vector<MappedPolylineFile::Polyline> Chunk;
+    size_t NumPolylines(0);
+    while (In.NextChunk(MaxVertices, Chunk))
+    {
+        size_t NumVertices(0);
+        for (const MappedPolylineFile::Polyline& Polyline : Chunk) NumVertices += Polyline.NumVertices;
+        EXPECT_TRUE(NumVertices <= MaxVertices || Chunk.size() == 1) << NumVertices << " vertices";
+        NumPolylines += Chunk.size();
+    }
+    EXPECT_EQ(NumPolylines, Polylines.size());
+    EXPECT_TRUE(In.IsComplete());
+
+    In.Close();
+    std::filesystem::remove(Path);
+}
+
+TEST(PolylineStream, RejectsOutputOverInput)
+{
+    const std::string Path = TempPath("polylinestream-test-same.kply");
+    ASSERT_TRUE(WritePolylines(Path, RandomPolylines(10)));
+
+    //The same file under another name must not be truncated while it is mapped
+    const std::string OtherName =
+        (std::filesystem::temp_directory_path() / "." / "polylinestream-test-same.kply").string();
+    EXPECT_FALSE(SubdividePolylineFile(Path, Path, mat4(1), ChaikinSubdivision::Method::CornerCutting, 64, 0.001f));
+    EXPECT_FALSE(SubdividePolylineFile(Path, OtherName, mat4(1), ChaikinSubdivision::Method::CornerCutting, 64, 0.001f));
+
+    MappedPolylineFile In;
+    ASSERT_TRUE(In.Open(Path));
+    EXPECT_EQ(In.GetNumPolylines(), 10u);
+
+    In.Close();
+    std::filesystem::remove(Path);
+}
+
+TEST(PolylineStream, RejectsPolylinesBeyondVertexCount)
+{
+    if (sizeof(size_t) <= sizeof(uint32_t)) return;
+
+    const std::string Path = TempPath("polylinestream-test-oversized.kply");
+    const std::vector<std::vector<vec3>> Polylines = RandomPolylines(1);
+    PolylineFileWriter Writer;
+    ASSERT_TRUE(Writer.Open(Path));
+
+    //The count is checked before any vertex is read, so the vertices need not exist
+    const size_t TooMany = size_t(std::numeric_limits<uint32_t>::max()) + 1;
+    EXPECT_FALSE(Writer.Append(Polylines[0].data(), TooMany));
+    EXPECT_TRUE(Writer.Append(Polylines[0].data(), Polylines[0].size()));
+    ASSERT_TRUE(Writer.Close());
+
+    MappedPolylineFile In;
+    ASSERT_TRUE(In.Open(Path));
+    EXPECT_EQ(In.GetNumPolylines(), 1u);
+
+    In.Close();
+    std::filesystem::remove(Path);
+}
+
+TEST(PolylineStream, ReportsTruncatedInput)
+{
+    const std::string InPath = TempPath("polylinestream-test-truncated.kply");
+    const std::string OutPath = TempPath("polylinestream-test-truncated-out.kply");
+    ASSERT_TRUE(WritePolylines(InPath, RandomPolylines(20)));
+    std::filesystem::resize_file(InPath, std::filesystem::file_size(InPath) - 5);
+
+    EXPECT_FALSE(SubdividePolylineFile(InPath, OutPath, mat4(1), ChaikinSubdivision::Method::CornerCutting, 64, 0.001f));
+
+    std::filesystem::remove(InPath);
+    std::filesystem::remove(OutPath);
+}
+
+} // namespace
+} // namespace
@@ -0,0 +1,86 @@
+/*********************************************************************
+ *  Author  : Tino Weinkauf
+ *  Init    : Sunday, October 18, 2026 - 14:26:51
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/labcolor/templaterecolor.h>
+
+#include <random>
+#include <vector>
+
+namespace inviwo
+{
+namespace kth
+{
+
+namespace
+{
+
+/*  Random pixels, most of them ordinary, with pure red template pixels and pixels that
+    are red except for a single green or blue bit mixed in.
+*/
+std::vector<glm::u8vec3> RandomRow(std::mt19937& Rng, size_t N)
+{
+    std::uniform_int_distribution<int> Byte(0, 255);
+    std::uniform_int_distribution<int> Kind(0, 9);
+    std::uniform_int_distribution<int> Bit(0, 7);
+    std::vector<glm::u8vec3> Row(N);
+    for (glm::u8vec3& Pixel : Row)
+    {
+        Pixel = glm::u8vec3(Byte(Rng), Byte(Rng), Byte(Rng));
+        const int k = Kind(Rng);
+        if (k < 3) Pixel.g = Pixel.b = 0;
+        else if (k == 3) Pixel = glm::u8vec3(Pixel.r, 1 << Bit(Rng), 0);
+        else if (k == 4) Pixel = glm::u8vec3(Pixel.r, 0, 1 << Bit(Rng));
+    }
+    return Row;
+}
+
+} // namespace
+
+/*  The block test must find every pure red pixel, wherever it sits in its block of 16,
+    and rows of any length must be recolored like one pixel at a time.
+*/
+TEST(TemplateRecolor, RowMatchesPixelByPixel)
+{
+    TemplateRecolor Recolor;
+    for (int Marker(0); Marker < 256; Marker += 3)
+    {
+        Recolor.SetColor(static_cast<unsigned char>(Marker),
+                         glm::u8vec3(255 - Marker, Marker / 2, 17));
+    }
+
+    std::mt19937 Rng(11);
+    for (size_t N : {0, 1, 15, 16, 17, 31, 48, 100, 1000})
+    {
+        const std::vector<glm::u8vec3> Row = RandomRow(Rng, N);
+        std::vector<glm::u8vec3> Expected(Row);
+        for (glm::u8vec3& Pixel : Expected)
+        {
+            if (Pixel.g == 0 && Pixel.b == 0 && Recolor.HasColor(Pixel.r))
+            {
+                Pixel = glm::u8vec3(255 - Pixel.r, Pixel.r / 2, 17);
+            }
+        }
+
+        std::vector<glm::u8vec3> Actual(Row);
+        Recolor.RecolorRow(Actual.data(), N);
+        for (size_t i(0); i < N; i++)
+        {
+            EXPECT_EQ(Actual[i], Expected[i]) << "N = " << N << ", i = " << i;
+        }
+    }
+}
+
+} // namespace
+} // namespace
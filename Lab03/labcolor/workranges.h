@@ -0,0 +1,61 @@
+/*********************************************************************
+ *  Author  : Tino Weinkauf
+ *  Init    : Sunday, October 18, 2026 - 02:31:50
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#pragma once
+
+#include <inviwo/core/util/foreach.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace inviwo
+{
+namespace kth
+{
+
+/*  Splits the items [0, NumItems) into contiguous ranges of about equal work and calls
+    Function(First, End) for each range as one job on Inviwo's thread pool, whose threads
+    keep their thread_local state from call to call. Offsets[i] is the amount of work
+    before item i, so Offsets has NumItems + 1 entries.
+
+    Small amounts of work are done on the calling thread.
+*/
+template <typename Function>
+void ForEachWorkRange(const std::vector<size_t>& Offsets, Function&& F)
+{
+    constexpr size_t MinWorkPerThread = size_t(1) << 14;
+
+    const size_t NumItems = Offsets.size() - 1;
+    const size_t TotalWork = Offsets.back();
+    const size_t MaxThreads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    const size_t NumRanges = std::min({MaxThreads, NumItems, std::max<size_t>(1, TotalWork / MinWorkPerThread)});
+    if (NumRanges <= 1)
+    {
+        F(size_t(0), NumItems);
+        return;
+    }
+
+    //First and end item of every range
+    std::vector<std::pair<size_t, size_t>> Ranges(NumRanges, {NumItems, NumItems});
+    for (size_t r(0); r < NumRanges; r++)
+    {
+        Ranges[r].first = std::lower_bound(Offsets.begin(), Offsets.end() - 1, r * TotalWork / NumRanges) - Offsets.begin();
+        if (r > 0) Ranges[r - 1].second = Ranges[r].first;
+    }
+
+    util::forEachParallel(Ranges, [&F](const std::pair<size_t, size_t>& Range) { F(Range.first, Range.second); },
+                          NumRanges);
+}
+
+} // namespace
+} // namespace
@@ -0,0 +1,80 @@
+/*********************************************************************
+ *  Author  : Himangshu Saikia
+ *  Init    : Saturday, October 17, 2026 - 10:12:31
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#pragma once
+
+#include <labraytracer/labraytracermoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace inviwo {
+
+/** \class AABB
+    \brief Axis-aligned bounding box of a renderable, used by the BVH.
+
+    A default constructed box is empty, i.e. lower > upper, so that extending it
+    with the first point or box yields exactly that point or box.
+
+    @author Himangshu Saikia
+*/
+struct AABB {
+    vec3 lower = vec3(std::numeric_limits<float>::max());
+    vec3 upper = vec3(std::numeric_limits<float>::lowest());
+
+    AABB() = default;
+    AABB(const vec3& lower_, const vec3& upper_) : lower(lower_), upper(upper_) {}
+
+    void extend(const vec3& p) {
+        lower = glm::min(lower, p);
+        upper = glm::max(upper, p);
+    }
+
+    void extend(const AABB& box) {
+        lower = glm::min(lower, box.lower);
+        upper = glm::max(upper, box.upper);
+    }
+
+    bool isEmpty() const { return lower.x > upper.x || lower.y > upper.y || lower.z > upper.z; }
+
+    vec3 centroid() const { return 0.5f * (lower + upper); }
+
+    vec3 extent() const { return upper - lower; }
+
+    float surfaceArea() const {
+        if (isEmpty()) return 0.0f;
+        const vec3 e = extent();
+        return 2.0f * (e.x * e.y + e.y * e.z + e.z * e.x);
+    }
+
+    /* Slab test against a ray given by its origin and the componentwise inverse of its
+       direction. On a hit, tNear holds the (clamped to zero) entry distance of the ray.
+
+       A zero direction component gives an infinite inverse. If the origin then lies exactly
+       on a face plane of that axis, 0 * inf yields NaN; the ray runs inside the face and
+       that axis does not bound it.
+    */
+    bool intersect(const vec3& origin, const vec3& invDirection, double maxLambda,
+                   float& tNear) const {
+        tNear = 0.0f;
+        float tFar = float(maxLambda);
+        for (int axis(0); axis < 3; axis++) {
+            const float t0 = (lower[axis] - origin[axis]) * invDirection[axis];
+            const float t1 = (upper[axis] - origin[axis]) * invDirection[axis];
+            if (std::isnan(t0) || std::isnan(t1)) continue;
+            tNear = std::max(tNear, std::min(t0, t1));
+            tFar = std::min(tFar, std::max(t0, t1));
+        }
+        return tNear <= tFar;
+    }
+};
+
+}  // namespace inviwo
@@ -0,0 +1,47 @@
+/*********************************************************************
+ *  Author  : Himangshu Saikia
+ *  Init    : Saturday, October 17, 2026 - 15:05:52
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#include <labraytracer/accumulationbuffer.h>
+#include <cmath>
+
+namespace inviwo {
+
+bool AccumulationBuffer::update(const size2_t& resolution, uint64_t signature) {
+    if (resolution.x == resolution_.x && resolution.y == resolution_.y &&
+        signature == signature_ && !mean_.empty()) {
+        return false;
+    }
+    resolution_ = resolution;
+    signature_ = signature;
+    reset();
+    return true;
+}
+
+void AccumulationBuffer::reset() {
+    mean_.assign(resolution_.x * resolution_.y, vec4(0.0f));
+    numSamples_ = 0;
+}
+
+vec2 AccumulationBuffer::getSampleOffset() const {
+    // R2 sequence, based on the plastic number
+    constexpr double a1 = 0.7548776662466927;
+    constexpr double a2 = 0.5698402909980532;
+    double intPart;
+    return vec2(static_cast<float>(std::modf(0.5 + a1 * numSamples_, &intPart)),
+                static_cast<float>(std::modf(0.5 + a2 * numSamples_, &intPart)));
+}
+
+vec4 AccumulationBuffer::accumulate(size_t i, const vec4& sample) {
+    vec4& mean = mean_[i];
+    mean += (sample - mean) / float(numSamples_ + 1);
+    return mean;
+}
+
+}  // namespace inviwo
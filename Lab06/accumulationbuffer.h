@@ -0,0 +1,67 @@
+/*********************************************************************
+ *  Author  : Himangshu Saikia
+ *  Init    : Saturday, October 17, 2026 - 15:05:52
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#pragma once
+
+#include <labraytracer/labraytracermoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <cstdint>
+
+namespace inviwo {
+
+/** \class AccumulationBuffer
+    \brief Float image that averages samples over several frames for progressive rendering.
+
+    Call update() at the start of every process() with the current SceneSignature. As long
+    as resolution and signature stay the same, every pass blends one new sample per pixel
+    into the running mean. Any change starts over from zero samples.
+
+    @author Himangshu Saikia
+*/
+class IVW_MODULE_LABRAYTRACER_API AccumulationBuffer {
+    //Construction / Deconstruction
+public:
+    AccumulationBuffer() = default;
+    virtual ~AccumulationBuffer() = default;
+
+    //Methods
+public:
+    /// Returns true if the accumulated samples were discarded.
+    bool update(const size2_t& resolution, uint64_t signature);
+    void reset();
+
+    /// Sub-pixel position in [0,1)^2 to sample in the current pass. The first pass samples
+    /// the pixel center, later passes follow the R2 low-discrepancy sequence.
+    vec2 getSampleOffset() const;
+
+    /// Blends a sample into pixel i and returns the new mean. Different pixels may be
+    /// accumulated concurrently.
+    vec4 accumulate(size_t i, const vec4& sample);
+
+    /// Marks the current pass as complete.
+    void finishPass() { numSamples_++; }
+
+    size_t getNumSamples() const { return numSamples_; }
+    void setMaxSamples(size_t maxSamples) { maxSamples_ = maxSamples; }
+    bool isConverged() const { return maxSamples_ > 0 && numSamples_ >= maxSamples_; }
+
+    const size2_t& getResolution() const { return resolution_; }
+    const std::vector<vec4>& getMean() const { return mean_; }
+
+    //Attributes
+private:
+    size2_t resolution_{0, 0};
+    uint64_t signature_ = 0;
+    std::vector<vec4> mean_;
+    size_t numSamples_ = 0;
+    size_t maxSamples_ = 0;
+};
+
+}  // namespace inviwo
@@ -0,0 +1,397 @@
+/*********************************************************************
+ *  Author  : Himangshu Saikia
+ *  Init    : Saturday, October 17, 2026 - 19:14:26
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+/*  Headless offline renderer.
+
+    Builds the same renderables and materials as the ray tracer processor from a scene
+    description file and renders a sequence of frames on all cores, without any window or
+    OpenGL context.
+
+    Usage: offlinerenderer scene.txt [--frames N] [--threads N] [--output prefix]
+
+    Unknown options, options without a value and counts that are not whole numbers print the
+    usage and give exit code 2. --frames must be positive, --threads 0 uses all hardware
+    threads. Errors in the scene file give exit code 1.
+
+    Scene description, one statement per line, '#' starts a comment:
+
+      resolution <width> <height>
+      frames <count>
+      output <prefix>                         frames go to <prefix>_0000.ppm, ...
+      format ppm|pfm                          8-bit sRGB-clamped or 32-bit float image
+      camera <eye xyz> <target xyz> <fov in degrees>
+      turntable <degrees>                     camera orbit around the target over all frames
+      light <position xyz> <ambient rgb> <diffuse rgb> <specular rgb>
+      material <name> <shininess> <ambient rgb> <diffuse rgb> <specular rgb>
+      sphere <center xyz> <radius> <material>
+      triangle <v0 xyz> <v1 xyz> <v2 xyz> <material>
+      mesh <file.obj> <material>              'v' and 'f' records only, polygons are fanned
+*/
+
+#include <labraytracer/bvh.h>
+#include <labraytracer/phongmaterial.h>
+#include <labraytracer/sphere.h>
+#include <labraytracer/tiledrenderer.h>
+#include <labraytracer/triangle.h>
+#include <labraytracer/trianglemesh.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+
+using namespace inviwo;
+
+namespace {
+
+struct Camera {
+    vec3 eye = vec3(0, 0, 10);
+    vec3 target = vec3(0, 0, 0);
+    float fov = 45.0f;
+};
+
+struct Scene {
+    size2_t resolution{640, 480};
+    size_t frames = 1;
+    std::string output = "frame";
+    bool floatOutput = false;
+    Camera camera;
+    float turntable = 0.0f;
+    std::vector<Light> lights;
+    std::vector<std::shared_ptr<Renderable>> renderables;
+    std::vector<std::shared_ptr<Material>> materials;  // one per renderable
+};
+
+vec3 readVec3(std::istream& is) {
+    vec3 v;
+    is >> v.x >> v.y >> v.z;
+    return v;
+}
+
+/*  Reads the 'v' and 'f' records of an OBJ file. Faces with more than three corners are
+    split into a triangle fan. Problems are reported with the line of the OBJ file.
+*/
+bool loadObj(const std::string& path, std::vector<vec3>& vertices, std::vector<uint32_t>& indices) {
+    std::ifstream file(path);
+    if (!file) return false;
+    std::string line;
+    size_t lineNumber = 0;
+    std::vector<uint32_t> corners;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        std::istringstream is(line);
+        std::string keyword;
+        is >> keyword;
+        if (keyword == "v") {
+            vertices.push_back(readVec3(is));
+        } else if (keyword == "f") {
+            // Only the position index of 'v/vt/vn' records is used. Indices count from 1,
+            // relative (negative) indices are not supported.
+            corners.clear();
+            std::string corner;
+            while (is >> corner) {
+                char* end = nullptr;
+                const long index = std::strtol(corner.c_str(), &end, 10);
+                if (end == corner.c_str() || (*end != '\0' && *end != '/')) {
+                    std::fprintf(stderr, "%s:%zu: invalid face corner '%s'\n", path.c_str(),
+                                 lineNumber, corner.c_str());
+                    return false;
+                }
+                if (index < 1 || size_t(index) > vertices.size()) {
+                    std::fprintf(stderr, "%s:%zu: vertex index %ld out of range 1..%zu\n",
+                                 path.c_str(), lineNumber, index, vertices.size());
+                    return false;
+                }
+                corners.push_back(uint32_t(index - 1));
+            }
+            if (corners.size() < 3) {
+                std::fprintf(stderr, "%s:%zu: face with fewer than three corners\n",
+                             path.c_str(), lineNumber);
+                return false;
+            }
+            for (size_t k(1); k + 1 < corners.size(); k++) {
+                indices.insert(indices.end(), {corners[0], corners[k], corners[k + 1]});
+            }
+        }
+    }
+    return true;
+}
+
+bool loadScene(const std::string& path, Scene& scene) {
+    std::ifstream file(path);
+    if (!file) {
+        std::fprintf(stderr, "Could not open scene %s\n", path.c_str());
+        return false;
+    }
+
+    std::map<std::string, std::shared_ptr<Material>> materials;
+    auto findMaterial = [&](const std::string& name, size_t lineNumber) {
+        auto it = materials.find(name);
+        if (it == materials.end()) {
+            std::fprintf(stderr, "%s:%zu: unknown material '%s'\n", path.c_str(), lineNumber,
+                         name.c_str());
+            return std::shared_ptr<Material>();
+        }
+        return it->second;
+    };
+
+    std::string line;
+    size_t lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        line = line.substr(0, line.find('#'));
+        std::istringstream is(line);
+        std::string keyword;
+        if (!(is >> keyword)) continue;
+
+        if (keyword == "resolution") {
+            is >> scene.resolution.x >> scene.resolution.y;
+        } else if (keyword == "frames") {
+            is >> scene.frames;
+        } else if (keyword == "output") {
+            is >> scene.output;
+        } else if (keyword == "format") {
+            std::string format;
+            is >> format;
+            if (format != "ppm" && format != "pfm") {
+                std::fprintf(stderr, "%s:%zu: unknown format '%s', expected ppm or pfm\n",
+                             path.c_str(), lineNumber, format.c_str());
+                return false;
+            }
+            scene.floatOutput = (format == "pfm");
+        } else if (keyword == "camera") {
+            scene.camera.eye = readVec3(is);
+            scene.camera.target = readVec3(is);
+            is >> scene.camera.fov;
+        } else if (keyword == "turntable") {
+            is >> scene.turntable;
+        } else if (keyword == "light") {
+            const vec3 position = readVec3(is);
+            const vec3 ambient = readVec3(is);
+            const vec3 diffuse = readVec3(is);
+            const vec3 specular = readVec3(is);
+            scene.lights.emplace_back(position, ambient, diffuse, specular);
+        } else if (keyword == "material") {
+            std::string name;
+            double shininess;
+            is >> name >> shininess;
+            const vec3 ambient = readVec3(is);
+            const vec3 diffuse = readVec3(is);
+            const vec3 specular = readVec3(is);
+            materials[name] = std::make_shared<PhongMaterial>(diffuse, 1.0, shininess, ambient,
+                                                              diffuse, specular);
+        } else if (keyword == "sphere") {
+            const vec3 center = readVec3(is);
+            double radius;
+            std::string material;
+            is >> radius >> material;
+            scene.renderables.push_back(std::make_shared<Sphere>(center, radius));
+            scene.materials.push_back(findMaterial(material, lineNumber));
+        } else if (keyword == "triangle") {
+            const vec3 v0 = readVec3(is);
+            const vec3 v1 = readVec3(is);
+            const vec3 v2 = readVec3(is);
+            std::string material;
+            is >> material;
+            scene.renderables.push_back(std::make_shared<Triangle>(v0, v1, v2));
+            scene.materials.push_back(findMaterial(material, lineNumber));
+        } else if (keyword == "mesh") {
+            std::string objPath, material;
+            is >> objPath >> material;
+            std::vector<vec3> vertices;
+            std::vector<uint32_t> indices;
+            if (!loadObj(objPath, vertices, indices)) {
+                std::fprintf(stderr, "%s:%zu: could not read mesh %s\n", path.c_str(),
+                             lineNumber, objPath.c_str());
+                return false;
+            }
+            scene.renderables.push_back(std::make_shared<TriangleMesh>(vertices, indices));
+            scene.materials.push_back(findMaterial(material, lineNumber));
+        } else {
+            std::fprintf(stderr, "%s:%zu: unknown statement '%s'\n", path.c_str(), lineNumber,
+                         keyword.c_str());
+            return false;
+        }
+
+        if (is.fail()) {
+            std::fprintf(stderr, "%s:%zu: missing or invalid values for '%s'\n", path.c_str(),
+                         lineNumber, keyword.c_str());
+            return false;
+        }
+        if (!scene.materials.empty() && !scene.materials.back()) return false;
+    }
+    return true;
+}
+
+/*  Camera of the given frame, orbiting the target about the y-axis for turntables.
+*/
+Camera frameCamera(const Scene& scene, size_t frame) {
+    Camera camera = scene.camera;
+    if (scene.turntable != 0.0f && scene.frames > 0) {
+        const float angle = glm::radians(scene.turntable) * frame / scene.frames;
+        const vec3 offset = camera.eye - camera.target;
+        camera.eye = camera.target + vec3(std::cos(angle) * offset.x + std::sin(angle) * offset.z,
+                                          offset.y,
+                                          -std::sin(angle) * offset.x + std::cos(angle) * offset.z);
+    }
+    return camera;
+}
+
+vec4 shadePixel(const Scene& scene, const RenderableBVH& bvh, const Ray& ray) {
+    RayIntersection intersection;
+    size_t index;
+    if (!bvh.closestIntersection(ray, 1e30, intersection, &index)) return vec4(0, 0, 0, 1);
+
+    const vec3 position = intersection.getPosition();
+    const vec3 normal = glm::normalize(intersection.getNormal());
+    vec3 color(0.0f);
+    for (const auto& light : scene.lights) {
+        // Shadow ray, started slightly off the surface towards the light
+        const vec3 toLight = light.getPosition() - position;
+        const float distance = glm::length(toLight);
+        const vec3 direction = toLight / distance;
+        const vec3 offset = (dot(direction, normal) >= 0 ? 1e-3f : -1e-3f) * normal;
+        if (bvh.anyIntersection(Ray(position + offset, direction), distance - 2e-3f)) continue;
+
+        const vec4 shaded = scene.materials[index]->shade(intersection, light);
+        color += vec3(shaded.r, shaded.g, shaded.b);
+    }
+    return vec4(color, 1.0f);
+}
+
+bool writeFrame(const std::string& path, const size2_t& resolution,
+                const std::vector<vec4>& pixels, bool floatOutput) {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+
+    if (floatOutput) {
+        // PFM stores rows bottom to top, a negative scale means little endian
+        std::fprintf(file, "PF\n%zu %zu\n-1.0\n", resolution.x, resolution.y);
+        std::vector<float> row(3 * resolution.x);
+        for (size_t y(resolution.y); y-- > 0;) {
+            for (size_t x(0); x < resolution.x; x++) {
+                const vec4& p = pixels[y * resolution.x + x];
+                row[3 * x] = p.r;
+                row[3 * x + 1] = p.g;
+                row[3 * x + 2] = p.b;
+            }
+            std::fwrite(row.data(), sizeof(float), row.size(), file);
+        }
+    } else {
+        std::fprintf(file, "P6\n%zu %zu\n255\n", resolution.x, resolution.y);
+        std::vector<unsigned char> bytes(3 * pixels.size());
+        for (size_t i(0); i < pixels.size(); i++) {
+            for (int c(0); c < 3; c++) {
+                bytes[3 * i + c] =
+                    static_cast<unsigned char>(glm::clamp(pixels[i][c], 0.0f, 1.0f) * 255.0f + 0.5f);
+            }
+        }
+        std::fwrite(bytes.data(), 1, bytes.size(), file);
+    }
+    return std::fclose(file) == 0;
+}
+
+int usage(const char* program) {
+    std::fprintf(stderr, "Usage: %s scene.txt [--frames N] [--threads N] [--output prefix]\n",
+                 program);
+    return 2;
+}
+
+/*  Parses a whole decimal number, positive or, if zero is allowed, non-negative.
+*/
+bool parseCount(const char* text, bool allowZero, size_t& count) {
+    // strtoull accepts a sign and wraps negative numbers around
+    if (*text < '0' || *text > '9') return false;
+    char* end = nullptr;
+    errno = 0;
+    const unsigned long long value = std::strtoull(text, &end, 10);
+    if (*end != '\0' || errno == ERANGE || value > std::numeric_limits<size_t>::max()) return false;
+    count = size_t(value);
+    return count > 0 || allowZero;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) return usage(argv[0]);
+
+    // Options are checked before the scene is loaded and override it
+    size_t frames = 0, numThreads = 0;
+    bool hasFrames = false;
+    const char* output = nullptr;
+    for (int i(2); i < argc; i += 2) {
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "Missing value for %s\n", argv[i]);
+            return usage(argv[0]);
+        }
+        const char* value = argv[i + 1];
+        bool valid = true;
+        if (!std::strcmp(argv[i], "--frames")) valid = hasFrames = parseCount(value, false, frames);
+        else if (!std::strcmp(argv[i], "--threads")) valid = parseCount(value, true, numThreads);
+        else if (!std::strcmp(argv[i], "--output")) output = value;
+        else {
+            std::fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return usage(argv[0]);
+        }
+        if (!valid) {
+            std::fprintf(stderr, "Invalid value %s for %s\n", value, argv[i]);
+            return usage(argv[0]);
+        }
+    }
+
+    Scene scene;
+    if (!loadScene(argv[1], scene)) return 1;
+    if (hasFrames) scene.frames = frames;
+    if (output) scene.output = output;
+
+    TiledRenderer renderer;
+    renderer.setNumThreads(numThreads);
+
+    // The scene is static over the sequence, only the camera moves
+    RenderableBVH bvh;
+    bvh.update(scene.renderables);
+
+    std::vector<vec4> pixels(scene.resolution.x * scene.resolution.y);
+    for (size_t frame(0); frame < scene.frames; frame++) {
+        const Camera camera = frameCamera(scene, frame);
+        const vec3 forward = glm::normalize(camera.target - camera.eye);
+        const vec3 right = glm::normalize(glm::cross(forward, vec3(0, 1, 0)));
+        const vec3 up = glm::cross(right, forward);
+        const float tanHalfFov = std::tan(glm::radians(camera.fov) / 2);
+        const float aspect = float(scene.resolution.x) / scene.resolution.y;
+
+        const auto start = std::chrono::steady_clock::now();
+        renderer.render(scene.resolution, pixels.data(), [&](size_t x, size_t y) {
+            // Row 0 is the top of the image
+            const float px = (2.0f * (x + 0.5f) / scene.resolution.x - 1.0f) * tanHalfFov * aspect;
+            const float py = (1.0f - 2.0f * (y + 0.5f) / scene.resolution.y) * tanHalfFov;
+            const vec3 direction = glm::normalize(forward + px * right + py * up);
+            return shadePixel(scene, bvh, Ray(camera.eye, direction));
+        });
+        const double seconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        char suffix[32];
+        std::snprintf(suffix, sizeof(suffix), "_%04zu.%s", frame, scene.floatOutput ? "pfm" : "ppm");
+        const std::string path = scene.output + suffix;
+        if (!writeFrame(path, scene.resolution, pixels, scene.floatOutput)) {
+            std::fprintf(stderr, "Could not write %s\n", path.c_str());
+            return 1;
+        }
+        std::printf("%s (%.2f s)\n", path.c_str(), seconds);
+    }
+    return 0;
+}
@@ -0,0 +1,496 @@
+/*********************************************************************
+ *  Author  : Himangshu Saikia
+ *  Init    : Saturday, October 17, 2026 - 18:30:44
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+/*  Ray tracer benchmark suite.
+
+    Runs without canvas or OpenGL context on procedural scenes generated from a fixed seed:
+    random spheres, a tessellated triangle mesh and a multi-light Phong scene. Reports
+    rays/sec, intersections/sec and shading ns/sample for Sphere, Triangle, TriangleMesh and
+    PhongMaterial as a flat JSON object.
+
+    The shadow-ray metrics answer the occlusion query of shadow rays, which stops at the first
+    blocker, once through closestIntersection and once through anyIntersection. Both have to
+    find the same number of occluded rays, otherwise the run fails.
+
+    Usage: raytracerbenchmark [--scale s] [--runs 5] [--json out.json] [--baseline base.json]
+                              [--tolerance 0.1]
+
+    Every timing is the median of --runs runs after one untimed warm-up run, so that cold
+    caches and page faults of the first run do not count.
+
+    Unknown options, options without a value and values that are not numbers where one is
+    expected print the usage and give exit code 2. So does a JSON file that cannot be
+    written.
+
+    With a baseline, every metric is compared against the baseline value. Throughput metrics
+    (*_per_sec) may not drop and timings (*_ns) may not rise by more than the tolerance;
+    otherwise the regressions are listed and the exit code is 1.
+*/
+
+#include <labraytracer/bvh.h>
+#include <labraytracer/phongmaterial.h>
+#include <labraytracer/sphere.h>
+#include <labraytracer/spherekernel.h>
+#include <labraytracer/triangle.h>
+#include <labraytracer/trianglemesh.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace inviwo;
+
+namespace {
+
+using Metrics = std::map<std::string, double>;
+
+constexpr unsigned Seed = 1234;
+
+// Timed runs per measurement, set with --runs
+int numRuns = 5;
+
+/*  Median wall time of f over numRuns runs, after one warm-up run that is not timed.
+    Counters that f increments therefore count numRuns + 1 runs.
+*/
+template <typename Function>
+double seconds(Function&& f) {
+    f();
+    std::vector<double> times(numRuns);
+    for (auto& time : times) {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+    std::nth_element(times.begin(), times.begin() + times.size() / 2, times.end());
+    return times[times.size() / 2];
+}
+
+/*  Primary rays of a pinhole camera at (0, 0, 30) looking down -z.
+*/
+std::vector<Ray> cameraRays(size_t width, size_t height) {
+    std::vector<Ray> rays;
+    rays.reserve(width * height);
+    const vec3 eye(0, 0, 30);
+    for (size_t y(0); y < height; y++) {
+        for (size_t x(0); x < width; x++) {
+            const vec3 target((x + 0.5f) / width * 24.0f - 12.0f,
+                              (y + 0.5f) / height * 24.0f - 12.0f, 0.0f);
+            rays.emplace_back(eye, glm::normalize(target - eye));
+        }
+    }
+    return rays;
+}
+
+/*  Random rays through the scene volume, with their ray parameter at the far end.
+*/
+void randomRays(std::mt19937& rng, size_t n, std::vector<Ray>& rays,
+                std::vector<double>& maxLambdas) {
+    std::uniform_real_distribution<float> position(-12.0f, 12.0f);
+    rays.clear();
+    maxLambdas.clear();
+    for (size_t i(0); i < n; i++) {
+        const vec3 from(position(rng), position(rng), position(rng));
+        const vec3 to(position(rng), position(rng), position(rng));
+        rays.emplace_back(from, glm::normalize(to - from));
+        maxLambdas.push_back(glm::length(to - from));
+    }
+}
+
+/*  UV sphere with the given number of rings and segments, centered at the origin.
+*/
+void tessellatedSphere(size_t rings, size_t segments, float radius, std::vector<vec3>& vertices,
+                       std::vector<uint32_t>& indices) {
+    for (size_t i(0); i <= rings; i++) {
+        const float theta = float(i * M_PI) / rings;
+        for (size_t j(0); j < segments; j++) {
+            const float phi = float(j * 2 * M_PI) / segments;
+            vertices.emplace_back(radius * std::sin(theta) * std::cos(phi),
+                                  radius * std::sin(theta) * std::sin(phi),
+                                  radius * std::cos(theta));
+        }
+    }
+    for (size_t i(0); i < rings; i++) {
+        for (size_t j(0); j < segments; j++) {
+            const uint32_t a = uint32_t(i * segments + j);
+            const uint32_t b = uint32_t(i * segments + (j + 1) % segments);
+            const uint32_t c = a + uint32_t(segments);
+            const uint32_t d = b + uint32_t(segments);
+            indices.insert(indices.end(), {a, c, b, b, c, d});
+        }
+    }
+}
+
+double traceAll(const RenderableBVH& bvh, const std::vector<Ray>& rays, size_t& hits) {
+    return seconds([&]() {
+        for (const auto& ray : rays) {
+            RayIntersection intersection;
+            if (bvh.closestIntersection(ray, 1e30, intersection)) hits++;
+        }
+    });
+}
+
+template <typename Query>
+double queryAll(const std::vector<std::shared_ptr<Renderable>>& objects,
+                const std::vector<Ray>& rays, const std::vector<double>& maxLambdas,
+                size_t& hits, Query&& query) {
+    return seconds([&]() {
+        for (size_t i(0); i < rays.size(); i++) {
+            for (const auto& object : objects) {
+                if (query(*object, rays[i], maxLambdas[i])) hits++;
+            }
+        }
+    });
+}
+
+bool closestQuery(const Renderable& object, const Ray& ray, double maxLambda) {
+    RayIntersection intersection;
+    return object.closestIntersection(ray, maxLambda, intersection);
+}
+
+bool anyQuery(const Renderable& object, const Ray& ray, double maxLambda) {
+    return object.anyIntersection(ray, maxLambda);
+}
+
+size_t cameraSize(double scale) { return size_t(256 * std::sqrt(scale)); }
+
+void benchmarkSpheres(double scale, Metrics& metrics) {
+    std::mt19937 rng(Seed);
+    std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> radius(0.05f, 0.3f);
+
+    const size_t numSpheres = std::max<size_t>(size_t(20000 * scale), 256);
+    std::vector<std::shared_ptr<Renderable>> spheres;
+    std::vector<Kernel::SpherePacket> packets((numSpheres + 7) / 8);
+    for (size_t i(0); i < numSpheres; i++) {
+        const vec3 center(position(rng), position(rng), position(rng));
+        const float r = radius(rng);
+        spheres.push_back(std::make_shared<Sphere>(center, r));
+        Kernel::SpherePacket& packet = packets[i / 8];
+        packet.set(packet.count++, center, r);
+    }
+
+    RenderableBVH bvh;
+    // update() skips the rebuild for an unchanged scene, so every run has to invalidate
+    metrics["spheres.bvh_build_ns"] = seconds([&]() {
+        bvh.invalidate();
+        bvh.update(spheres);
+    }) * 1e9;
+
+    const auto rays = cameraRays(cameraSize(scale), cameraSize(scale));
+    size_t hits = 0;
+    metrics["spheres.rays_per_sec"] = rays.size() / traceAll(bvh, rays, hits);
+
+    // Raw kernel throughput on a subset, one sphere at a time and eight at a time
+    std::vector<Ray> testRays;
+    std::vector<double> maxLambdas;
+    randomRays(rng, 2000, testRays, maxLambdas);
+    const std::vector<std::shared_ptr<Renderable>> subset(spheres.begin(), spheres.begin() + 256);
+    const double numTests = double(subset.size()) * testRays.size();
+    metrics["sphere.closest_intersections_per_sec"] =
+        numTests / queryAll(subset, testRays, maxLambdas, hits, closestQuery);
+    metrics["sphere.any_intersections_per_sec"] =
+        numTests / queryAll(subset, testRays, maxLambdas, hits, anyQuery);
+
+    const double packet = seconds([&]() {
+        for (size_t i(0); i < testRays.size(); i++) {
+            for (size_t p(0); p < subset.size() / 8; p++) {
+                float lambda;
+                if (Kernel::intersectSpherePacket(packets[p], testRays[i].getOrigin(),
+                                                  testRays[i].getDirection(),
+                                                  float(maxLambdas[i]), lambda) >= 0) {
+                    hits++;
+                }
+            }
+        }
+    });
+    metrics["sphere.packet_intersections_per_sec"] = numTests / packet;
+    metrics["spheres.checksum_hits"] = double(hits);
+}
+
+void benchmarkTriangles(double scale, Metrics& metrics) {
+    std::mt19937 rng(Seed);
+
+    std::vector<vec3> vertices;
+    std::vector<uint32_t> indices;
+    const size_t rings = std::max<size_t>(size_t(200 * std::sqrt(scale)), 16);
+    tessellatedSphere(rings, 2 * rings, 10.0f, vertices, indices);
+
+    std::shared_ptr<TriangleMesh> mesh;
+    metrics["mesh.bvh_build_ns"] =
+        seconds([&]() { mesh = std::make_shared<TriangleMesh>(vertices, indices); }) * 1e9;
+    metrics["mesh.num_triangles"] = double(mesh->getNumTriangles());
+
+    RenderableBVH bvh;
+    bvh.update({mesh});
+    const auto rays = cameraRays(cameraSize(scale), cameraSize(scale));
+    size_t hits = 0;
+    metrics["mesh.rays_per_sec"] = rays.size() / traceAll(bvh, rays, hits);
+
+    // Raw kernel throughput of individual Triangle objects
+    std::vector<Ray> testRays;
+    std::vector<double> maxLambdas;
+    randomRays(rng, 2000, testRays, maxLambdas);
+    std::vector<std::shared_ptr<Renderable>> triangles;
+    for (size_t t(0); t < 256; t++) {
+        triangles.push_back(std::make_shared<Triangle>(
+            vertices[indices[3 * t]], vertices[indices[3 * t + 1]], vertices[indices[3 * t + 2]]));
+    }
+    const double numTests = double(triangles.size()) * testRays.size();
+    metrics["triangle.closest_intersections_per_sec"] =
+        numTests / queryAll(triangles, testRays, maxLambdas, hits, closestQuery);
+    metrics["triangle.any_intersections_per_sec"] =
+        numTests / queryAll(triangles, testRays, maxLambdas, hits, anyQuery);
+    metrics["mesh.checksum_hits"] = double(hits);
+}
+
+/*  Shadow rays from random surface points towards a random light, occluded as soon as one
+    object blocks them, through the closest-hit path and the occlusion path.
+*/
+void benchmarkShadowRays(const char* name, const std::vector<std::shared_ptr<Renderable>>& objects,
+                         const std::vector<Ray>& rays, const std::vector<double>& maxLambdas,
+                         Metrics& metrics) {
+    const auto occlusion = [&](auto&& query, size_t& numOccluded) {
+        return seconds([&]() {
+            for (size_t i(0); i < rays.size(); i++) {
+                for (const auto& object : objects) {
+                    if (query(*object, rays[i], maxLambdas[i])) {
+                        numOccluded++;
+                        break;
+                    }
+                }
+            }
+        });
+    };
+    size_t numClosest = 0, numAny = 0;
+    const double closest = occlusion(closestQuery, numClosest);
+    const double any = occlusion(anyQuery, numAny);
+
+    const std::string prefix = std::string("shadow.") + name;
+    metrics[prefix + ".closest_rays_per_sec"] = rays.size() / closest;
+    metrics[prefix + ".any_rays_per_sec"] = rays.size() / any;
+    metrics[prefix + ".any_speedup"] = closest / any;
+    metrics[prefix + ".occluded_mismatch"] =
+        double(numClosest > numAny ? numClosest - numAny : numAny - numClosest);
+}
+
+void benchmarkShadowRays(double scale, Metrics& metrics) {
+    std::mt19937 rng(Seed);
+    std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> size(0.2f, 1.5f);
+
+    std::vector<std::shared_ptr<Renderable>> spheres, triangles;
+    for (int i(0); i < 64; i++) {
+        const vec3 center(position(rng), position(rng), position(rng));
+        spheres.push_back(std::make_shared<Sphere>(center, size(rng)));
+        triangles.push_back(std::make_shared<Triangle>(
+            center, center + vec3(size(rng), 0, position(rng) * 0.1f),
+            center + vec3(0, size(rng), position(rng) * 0.1f)));
+    }
+
+    std::vector<Ray> rays;
+    std::vector<double> maxLambdas;
+    randomRays(rng, std::max<size_t>(size_t(200000 * scale), 1000), rays, maxLambdas);
+
+    benchmarkShadowRays("sphere", spheres, rays, maxLambdas, metrics);
+    benchmarkShadowRays("triangle", triangles, rays, maxLambdas, metrics);
+}
+
+void benchmarkPhong(double scale, Metrics& metrics) {
+    std::mt19937 rng(Seed);
+    std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+
+    std::vector<Light> lights;
+    for (int i(0); i < 8; i++) {
+        lights.emplace_back(vec3(position(rng), position(rng), 20.0f), vec3(0.2f), vec3(1.0f),
+                            vec3(1.0f));
+    }
+    PhongMaterial material(vec3(0, 0.4, 0.8), 1.0, 20.0, vec3(0.1f), vec3(0.5f), vec3(0.8f));
+
+    // Hits on a large sphere as seen from the camera
+    auto sphere = std::make_shared<Sphere>(vec3(0, 0, 0), 11.0);
+    std::vector<RayIntersection> intersections;
+    HitBatch batch;
+    for (const auto& ray : cameraRays(cameraSize(scale), cameraSize(scale))) {
+        RayIntersection intersection;
+        if (sphere->closestIntersection(ray, 1e30, intersection)) {
+            intersections.push_back(intersection);
+            batch.push(intersection);
+        }
+    }
+
+    double checksum = 0;
+    const double single = seconds([&]() {
+        for (const auto& intersection : intersections) {
+            for (const auto& light : lights) checksum += material.shade(intersection, light).r;
+        }
+    });
+    std::vector<vec4> colors(batch.size());
+    ShadeScratch scratch;
+    scratch.resize(batch.size());
+    const double batched =
+        seconds([&]() { material.shadeBatch(batch, lights, scratch, colors.data()); });
+    for (const auto& color : colors) checksum += color.r;
+
+    const double numSamples = double(intersections.size()) * lights.size();
+    metrics["phong.shade_ns"] = single / numSamples * 1e9;
+    metrics["phong.shade_batch_ns"] = batched / numSamples * 1e9;
+    metrics["phong.checksum"] = checksum;
+}
+
+void writeJson(std::ostream& os, const Metrics& metrics) {
+    os << "{\n";
+    size_t i = 0;
+    for (const auto& metric : metrics) {
+        char value[64];
+        std::snprintf(value, sizeof(value), "%.6g", metric.second);
+        os << "  \"" << metric.first << "\": " << value << (++i < metrics.size() ? ",\n" : "\n");
+    }
+    os << "}\n";
+}
+
+/*  Reads the flat "key": number objects written by writeJson.
+*/
+Metrics readJson(std::istream& is) {
+    Metrics metrics;
+    std::string line;
+    while (std::getline(is, line)) {
+        const auto open = line.find('"');
+        if (open == std::string::npos) continue;
+        const auto close = line.find('"', open + 1);
+        if (close == std::string::npos) continue;
+        const auto colon = line.find(':', close);
+        if (colon == std::string::npos) continue;
+        metrics[line.substr(open + 1, close - open - 1)] =
+            std::strtod(line.c_str() + colon + 1, nullptr);
+    }
+    return metrics;
+}
+
+bool endsWith(const std::string& s, const char* suffix) {
+    const size_t n = std::strlen(suffix);
+    return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
+int countRegressions(const Metrics& metrics, const Metrics& baseline, double tolerance) {
+    int numRegressions = 0;
+    for (const auto& reference : baseline) {
+        const auto it = metrics.find(reference.first);
+        if (it == metrics.end() || reference.second <= 0) continue;
+        const double ratio = it->second / reference.second;
+        const bool slower = (endsWith(reference.first, "_per_sec") && ratio < 1.0 - tolerance) ||
+                            (endsWith(reference.first, "_ns") && ratio > 1.0 + tolerance);
+        if (slower) {
+            std::fprintf(stderr, "Regression in %s: %g (baseline %g)\n", reference.first.c_str(),
+                         it->second, reference.second);
+            numRegressions++;
+        }
+    }
+    return numRegressions;
+}
+
+int usage() {
+    std::fputs("Usage: raytracerbenchmark [--scale s] [--runs 5] [--json out.json] "
+               "[--baseline base.json] [--tolerance 0.1]\n",
+               stderr);
+    return 2;
+}
+
+/*  Parses a positive number, or a non-negative one if zero is allowed.
+*/
+bool parseNumber(const char* text, bool allowZero, double& value) {
+    char* end = nullptr;
+    value = std::strtod(text, &end);
+    return end != text && *end == '\0' && std::isfinite(value) &&
+           (value > 0 || (allowZero && value == 0));
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    double scale = 1.0;
+    double tolerance = 0.1;
+    const char* jsonPath = nullptr;
+    const char* baselinePath = nullptr;
+    for (int i(1); i < argc; i += 2) {
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "Missing value for %s\n", argv[i]);
+            return usage();
+        }
+        const char* value = argv[i + 1];
+        bool valid = true;
+        if (!std::strcmp(argv[i], "--scale")) valid = parseNumber(value, false, scale);
+        else if (!std::strcmp(argv[i], "--tolerance")) valid = parseNumber(value, true, tolerance);
+        else if (!std::strcmp(argv[i], "--runs")) {
+            double runs;
+            valid = parseNumber(value, false, runs) && runs == std::floor(runs) && runs <= 1000;
+            if (valid) numRuns = int(runs);
+        }
+        else if (!std::strcmp(argv[i], "--json")) jsonPath = value;
+        else if (!std::strcmp(argv[i], "--baseline")) baselinePath = value;
+        else {
+            std::fprintf(stderr, "Unknown option %s\n", argv[i]);
+            return usage();
+        }
+        if (!valid) {
+            std::fprintf(stderr, "Invalid value %s for %s\n", value, argv[i]);
+            return usage();
+        }
+    }
+
+    Metrics metrics;
+    benchmarkSpheres(scale, metrics);
+    benchmarkTriangles(scale, metrics);
+    benchmarkShadowRays(scale, metrics);
+    benchmarkPhong(scale, metrics);
+
+    if (jsonPath) {
+        std::ofstream file(jsonPath);
+        if (file) {
+            writeJson(file, metrics);
+            file.close();
+        }
+        if (!file) {
+            std::fprintf(stderr, "Could not write %s\n", jsonPath);
+            return 2;
+        }
+    } else {
+        std::ostringstream os;
+        writeJson(os, metrics);
+        std::fputs(os.str().c_str(), stdout);
+    }
+
+    for (const char* name :
+         {"shadow.sphere.occluded_mismatch", "shadow.triangle.occluded_mismatch"}) {
+        if (metrics[name] > 0) {
+            std::fprintf(stderr, "Closest-hit and occlusion path disagree: %s = %g\n", name,
+                         metrics[name]);
+            return 1;
+        }
+    }
+
+    if (baselinePath) {
+        std::ifstream file(baselinePath);
+        if (!file) {
+            std::fprintf(stderr, "Could not open baseline %s\n", baselinePath);
+            return 2;
+        }
+        return countRegressions(metrics, readJson(file), tolerance) > 0 ? 1 : 0;
+    }
+    return 0;
+}
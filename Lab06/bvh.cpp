@@ -0,0 +1,157 @@
+/*********************************************************************
+ *  Author  : Himangshu Saikia
+ *  Init    : Saturday, October 17, 2026 - 10:12:31
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#include <labraytracer/bvh.h>
+#include <algorithm>
+#include <array>
+#include <numeric>
+
+namespace inviwo {
+
+void BVH::clear() {
+    nodes_.clear();
+    indices_.clear();
+}
+
+void BVH::build(const std::vector<AABB>& primitiveBounds, uint32_t maxLeafSize) {
+    clear();
+    const uint32_t numPrimitives = static_cast<uint32_t>(primitiveBounds.size());
+    if (numPrimitives == 0) return;
+
+    indices_.resize(numPrimitives);
+    std::iota(indices_.begin(), indices_.end(), 0u);
+
+    std::vector<vec3> centroids(numPrimitives);
+    for (uint32_t i(0); i < numPrimitives; i++) {
+        centroids[i] = primitiveBounds[i].centroid();
+    }
+
+    // A binary tree with n leaves has at most 2n - 1 nodes.
+    nodes_.reserve(2 * numPrimitives - 1);
+    nodes_.emplace_back();
+    buildNode(0, 0, numPrimitives, 0, maxLeafSize, primitiveBounds, centroids);
+}
+
+void BVH::buildNode(uint32_t nodeIndex, uint32_t first, uint32_t count, int depth,
+                    uint32_t maxLeafSize, const std::vector<AABB>& primitiveBounds,
+                    const std::vector<vec3>& centroids) {
+    AABB bounds, centroidBounds;
+    for (uint32_t i(first); i < first + count; i++) {
+        bounds.extend(primitiveBounds[indices_[i]]);
+        centroidBounds.extend(centroids[indices_[i]]);
+    }
+    nodes_[nodeIndex].bounds = bounds;
+    nodes_[nodeIndex].offset = first;
+    nodes_[nodeIndex].count = count;
+
+    if (count <= maxLeafSize || depth >= MaxDepth) return;
+
+    // Split along the axis with the largest centroid extent
+    const vec3 extent = centroidBounds.extent();
+    int axis = 0;
+    if (extent.y > extent[axis]) axis = 1;
+    if (extent.z > extent[axis]) axis = 2;
+    // All centroids coincide, no split can separate them.
+    if (extent[axis] <= 0.0f) return;
+
+    const float lower = centroidBounds.lower[axis];
+    const float scale = NumBins / extent[axis];
+    auto binOf = [&](uint32_t primitive) {
+        const int bin = static_cast<int>((centroids[primitive][axis] - lower) * scale);
+        return std::min(bin, NumBins - 1);
+    };
+
+    struct Bin {
+        AABB bounds;
+        uint32_t count = 0;
+    };
+    std::array<Bin, NumBins> bins;
+    for (uint32_t i(first); i < first + count; i++) {
+        Bin& bin = bins[binOf(indices_[i])];
+        bin.bounds.extend(primitiveBounds[indices_[i]]);
+        bin.count++;
+    }
+
+    // Sweep from both sides to get the SAH cost of splitting after each bin
+    std::array<float, NumBins - 1> leftCost;
+    AABB leftBounds;
+    uint32_t leftCount = 0;
+    for (int i(0); i < NumBins - 1; i++) {
+        leftBounds.extend(bins[i].bounds);
+        leftCount += bins[i].count;
+        leftCost[i] = leftCount * leftBounds.surfaceArea();
+    }
+
+    float bestCost = std::numeric_limits<float>::max();
+    int bestSplit = -1;
+    AABB rightBounds;
+    uint32_t rightCount = 0;
+    for (int i(NumBins - 1); i > 0; i--) {
+        rightBounds.extend(bins[i].bounds);
+        rightCount += bins[i].count;
+        if (rightCount == 0 || rightCount == count) continue;
+        const float cost = leftCost[i - 1] + rightCount * rightBounds.surfaceArea();
+        if (cost < bestCost) {
+            bestCost = cost;
+            bestSplit = i - 1;
+        }
+    }
+    if (bestSplit < 0) return;
+
+    // Keep small nodes as leaves if splitting them does not pay off
+    const float leafCost = count * bounds.surfaceArea();
+    if (bestCost >= leafCost && count <= 4 * maxLeafSize) return;
+
+    auto itMiddle = std::partition(indices_.begin() + first, indices_.begin() + first + count,
+                                   [&](uint32_t primitive) { return binOf(primitive) <= bestSplit; });
+    const uint32_t numLeft = static_cast<uint32_t>(itMiddle - (indices_.begin() + first));
+
+    const uint32_t leftChild = static_cast<uint32_t>(nodes_.size());
+    nodes_.emplace_back();
+    nodes_.emplace_back();
+    nodes_[nodeIndex].offset = leftChild;
+    nodes_[nodeIndex].count = 0;
+
+    buildNode(leftChild, first, numLeft, depth + 1, maxLeafSize, primitiveBounds, centroids);
+    buildNode(leftChild + 1, first + numLeft, count - numLeft, depth + 1, maxLeafSize,
+              primitiveBounds, centroids);
+}
+
+void RenderableBVH::update(const std::vector<std::shared_ptr<Renderable>>& renderables) {
+    if (!dirty_ && renderables == renderables_) return;
+
+    renderables_ = renderables;
+    std::vector<AABB> bounds;
+    bounds.reserve(renderables_.size());
+    for (const auto& renderable : renderables_) {
+        bounds.push_back(renderable->getBoundingBox());
+    }
+    bvh_.build(bounds);
+    dirty_ = false;
+}
+
+bool RenderableBVH::closestIntersection(const Ray& ray, double maxLambda,
+                                        RayIntersection& intersection,
+                                        size_t* renderableIndex) const {
+    return bvh_.closest(ray, maxLambda, [&](uint32_t i, double& lambda) {
+        if (!renderables_[i]->closestIntersection(ray, lambda, intersection)) return false;
+        lambda = intersection.getLambda();
+        if (renderableIndex) *renderableIndex = i;
+        return true;
+    });
+}
+
+bool RenderableBVH::anyIntersection(const Ray& ray, double maxLambda) const {
+    return bvh_.any(ray, maxLambda, [&](uint32_t i, double lambda) {
+        return renderables_[i]->anyIntersection(ray, lambda);
+    });
+}
+
+}  // namespace inviwo
@@ -0,0 +1,235 @@
+/*********************************************************************
+ *  Author  : Himangshu Saikia
+ *  Init    : Saturday, October 17, 2026 - 10:12:31
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#pragma once
+
+#include <labraytracer/labraytracermoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <labraytracer/aabb.h>
+#include <labraytracer/ray.h>
+#include <labraytracer/rayintersection.h>
+#include <labraytracer/renderable.h>
+#include <cstdint>
+
+namespace inviwo {
+
+/** \class BVH
+    \brief Bounding volume hierarchy over a set of primitive bounding boxes.
+
+    The hierarchy is built top-down with binned surface area heuristic (SAH) splits
+    and stored as a flat array of nodes. The BVH itself knows nothing about the
+    primitives, the intersection of a primitive is delegated to a callback that
+    receives the index of the primitive in the array given to build().
+
+    @author Himangshu Saikia
+*/
+class IVW_MODULE_LABRAYTRACER_API BVH {
+    //Friends
+    //Types
+public:
+    struct Node {
+        AABB bounds;
+        // Leaf: index of the first primitive in indices_. Inner node: index of the left child,
+        // the right child is stored directly after it.
+        uint32_t offset = 0;
+        // Number of primitives in a leaf, zero for inner nodes.
+        uint32_t count = 0;
+    };
+
+    static constexpr int NumBins = 16;
+    static constexpr uint32_t MaxLeafSize = 4;
+    static constexpr int MaxDepth = 48;
+
+    //Construction / Deconstruction
+public:
+    BVH() = default;
+    virtual ~BVH() = default;
+
+    //Methods
+public:
+    /// Leaves hold up to maxLeafSize primitives, more only where the SAH or the depth limit
+    /// stops the split.
+    void build(const std::vector<AABB>& primitiveBounds, uint32_t maxLeafSize = MaxLeafSize);
+    void clear();
+    bool empty() const { return nodes_.empty(); }
+    const std::vector<Node>& nodes() const { return nodes_; }
+    /// Primitive indices in leaf order, a leaf covers [offset, offset + count).
+    const std::vector<uint32_t>& indices() const { return indices_; }
+
+    /* Finds the closest primitive along the ray.
+
+       intersect(primitiveIndex, maxLambda) is called for every primitive in a visited leaf.
+       It returns true if it found a hit closer than maxLambda and lowers maxLambda to the
+       distance of that hit, so that farther subtrees are culled.
+    */
+    template <typename Intersect>
+    bool closest(const Ray& ray, double& maxLambda, Intersect&& intersect) const;
+
+    /* Returns true as soon as intersect(primitiveIndex, maxLambda) reports a hit.
+    */
+    template <typename Intersect>
+    bool any(const Ray& ray, double maxLambda, Intersect&& intersect) const;
+
+    /* Same as closest(), but intersectLeaf(nodeIndex, maxLambda) is called once per visited
+       leaf, so that all primitives of a leaf can be tested at once.
+    */
+    template <typename IntersectLeaf>
+    bool closestLeaf(const Ray& ray, double& maxLambda, IntersectLeaf&& intersectLeaf) const;
+
+    /* Same as any(), but with one call of intersectLeaf(nodeIndex, maxLambda) per leaf.
+    */
+    template <typename IntersectLeaf>
+    bool anyLeaf(const Ray& ray, double maxLambda, IntersectLeaf&& intersectLeaf) const;
+
+private:
+    void buildNode(uint32_t nodeIndex, uint32_t first, uint32_t count, int depth,
+                   uint32_t maxLeafSize, const std::vector<AABB>& primitiveBounds,
+                   const std::vector<vec3>& centroids);
+
+    //Attributes
+private:
+    std::vector<Node> nodes_;
+    std::vector<uint32_t> indices_;
+};
+
+/** \class RenderableBVH
+    \brief BVH over the renderables of a scene.
+
+    update() only rebuilds the hierarchy if the list of renderables differs from the one
+    the hierarchy was built for, or if invalidate() has been called in the meantime.
+
+    @author Himangshu Saikia
+*/
+class IVW_MODULE_LABRAYTRACER_API RenderableBVH {
+    //Construction / Deconstruction
+public:
+    RenderableBVH() = default;
+    virtual ~RenderableBVH() = default;
+
+    //Methods
+public:
+    void update(const std::vector<std::shared_ptr<Renderable>>& renderables);
+    void invalidate() { dirty_ = true; }
+
+    bool closestIntersection(const Ray& ray, double maxLambda, RayIntersection& intersection,
+                             size_t* renderableIndex = nullptr) const;
+    bool anyIntersection(const Ray& ray, double maxLambda) const;
+
+    //Attributes
+private:
+    std::vector<std::shared_ptr<Renderable>> renderables_;
+    BVH bvh_;
+    bool dirty_ = true;
+};
+
+template <typename Intersect>
+bool BVH::closest(const Ray& ray, double& maxLambda, Intersect&& intersect) const {
+    return closestLeaf(ray, maxLambda, [&](uint32_t nodeIndex, double& lambda) {
+        const Node& node = nodes_[nodeIndex];
+        bool hit = false;
+        for (uint32_t i(0); i < node.count; i++) {
+            if (intersect(indices_[node.offset + i], lambda)) hit = true;
+        }
+        return hit;
+    });
+}
+
+template <typename Intersect>
+bool BVH::any(const Ray& ray, double maxLambda, Intersect&& intersect) const {
+    return anyLeaf(ray, maxLambda, [&](uint32_t nodeIndex, double lambda) {
+        const Node& node = nodes_[nodeIndex];
+        for (uint32_t i(0); i < node.count; i++) {
+            if (intersect(indices_[node.offset + i], lambda)) return true;
+        }
+        return false;
+    });
+}
+
+template <typename IntersectLeaf>
+bool BVH::closestLeaf(const Ray& ray, double& maxLambda, IntersectLeaf&& intersectLeaf) const {
+    if (nodes_.empty()) return false;
+
+    const vec3 origin = ray.getOrigin();
+    const vec3 invDirection = 1.0f / ray.getDirection();
+
+    struct Entry {
+        uint32_t node;
+        float tNear;
+    };
+    Entry stack[MaxDepth + 2];
+    int top = 0;
+
+    float tRoot;
+    if (!nodes_[0].bounds.intersect(origin, invDirection, maxLambda, tRoot)) return false;
+    stack[top++] = {0, tRoot};
+
+    bool hit = false;
+    while (top > 0) {
+        const Entry entry = stack[--top];
+        // A closer hit may have been found since this node was pushed.
+        if (entry.tNear > maxLambda) continue;
+
+        const Node& node = nodes_[entry.node];
+        if (node.count > 0) {
+            if (intersectLeaf(entry.node, maxLambda)) hit = true;
+            continue;
+        }
+
+        // Visit the nearer child first by pushing it last.
+        float tLeft, tRight;
+        const bool hitLeft =
+            nodes_[node.offset].bounds.intersect(origin, invDirection, maxLambda, tLeft);
+        const bool hitRight =
+            nodes_[node.offset + 1].bounds.intersect(origin, invDirection, maxLambda, tRight);
+        if (hitLeft && hitRight) {
+            if (tLeft <= tRight) {
+                stack[top++] = {node.offset + 1, tRight};
+                stack[top++] = {node.offset, tLeft};
+            } else {
+                stack[top++] = {node.offset, tLeft};
+                stack[top++] = {node.offset + 1, tRight};
+            }
+        } else if (hitLeft) {
+            stack[top++] = {node.offset, tLeft};
+        } else if (hitRight) {
+            stack[top++] = {node.offset + 1, tRight};
+        }
+    }
+    return hit;
+}
+
+template <typename IntersectLeaf>
+bool BVH::anyLeaf(const Ray& ray, double maxLambda, IntersectLeaf&& intersectLeaf) const {
+    if (nodes_.empty()) return false;
+
+    const vec3 origin = ray.getOrigin();
+    const vec3 invDirection = 1.0f / ray.getDirection();
+
+    uint32_t stack[MaxDepth + 2];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0) {
+        const uint32_t nodeIndex = stack[--top];
+        const Node& node = nodes_[nodeIndex];
+        float tNear;
+        if (!node.bounds.intersect(origin, invDirection, maxLambda, tNear)) continue;
+
+        if (node.count > 0) {
+            if (intersectLeaf(nodeIndex, maxLambda)) return true;
+        } else {
+            stack[top++] = node.offset + 1;
+            stack[top++] = node.offset;
+        }
+    }
+    return false;
+}
+
+}  // namespace inviwo
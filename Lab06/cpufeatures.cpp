@@ -0,0 +1,69 @@
+/*********************************************************************
+ *  Author  : Himangshu Saikia
+ *  Init    : Sunday, October 18, 2026 - 09:41:26
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#include <labraytracer/cpufeatures.h>
+
+#include <algorithm>
+#include <atomic>
+
+#if defined(LABRAYTRACER_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+namespace inviwo {
+
+namespace Kernel {
+
+namespace {
+
+SimdLevel detectSimdLevel() {
+#if defined(LABRAYTRACER_X86) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    // Also checks that the operating system saves the AVX registers
+    if (__builtin_cpu_supports("avx")) return SimdLevel::AVX;
+    if (__builtin_cpu_supports("sse2")) return SimdLevel::SSE2;
+    return SimdLevel::Scalar;
+#elif defined(LABRAYTRACER_X86) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    const bool osSavesYmm = (info[2] & (1 << 27)) && (_xgetbv(0) & 0x6) == 0x6;
+    if ((info[2] & (1 << 28)) && osSavesYmm) return SimdLevel::AVX;
+    if (info[3] & (1 << 26)) return SimdLevel::SSE2;
+    return SimdLevel::Scalar;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+std::atomic<int>& currentLevel() {
+    static std::atomic<int> level(static_cast<int>(supportedSimdLevel()));
+    return level;
+}
+
+}  // namespace
+
+SimdLevel supportedSimdLevel() {
+    static const SimdLevel supported = detectSimdLevel();
+    return supported;
+}
+
+SimdLevel simdLevel() {
+    return static_cast<SimdLevel>(currentLevel().load(std::memory_order_relaxed));
+}
+
+void setSimdLevel(SimdLevel level) {
+    const int capped = std::min(static_cast<int>(level), static_cast<int>(supportedSimdLevel()));
+    currentLevel().store(capped, std::memory_order_relaxed);
+}
+
+}  // namespace Kernel
+
+}  // namespace inviwo
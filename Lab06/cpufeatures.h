@@ -0,0 +1,47 @@
+/*********************************************************************
+ *  Author  : Himangshu Saikia
+ *  Init    : Sunday, October 18, 2026 - 09:41:26
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#pragma once
+
+#include <labraytracer/labraytracermoduledefine.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define LABRAYTRACER_X86
+#endif
+
+// Kernels for wider instruction sets are compiled for them function by function, so that the
+// module builds without architecture flags and picks the widest path at runtime.
+#if defined(LABRAYTRACER_X86) && (defined(__GNUC__) || defined(__clang__))
+#define LABRAYTRACER_TARGET_SSE2 __attribute__((target("sse2")))
+#define LABRAYTRACER_TARGET_AVX __attribute__((target("avx")))
+#else
+#define LABRAYTRACER_TARGET_SSE2
+#define LABRAYTRACER_TARGET_AVX
+#endif
+
+namespace inviwo {
+
+namespace Kernel {
+
+enum class SimdLevel { Scalar = 0, SSE2 = 1, AVX = 2 };
+
+/// Widest instruction set of this CPU (and operating system) that the kernels can use.
+IVW_MODULE_LABRAYTRACER_API SimdLevel supportedSimdLevel();
+
+/// The instruction set the kernels dispatch to, the supported one unless capped.
+IVW_MODULE_LABRAYTRACER_API SimdLevel simdLevel();
+
+/// Caps the instruction set of the kernels, to compare the paths in tests and benchmarks.
+/// Levels above the supported one are lowered to it.
+IVW_MODULE_LABRAYTRACER_API void setSimdLevel(SimdLevel level);
+
+}  // namespace Kernel
+
+}  // namespace inviwo
@@ -0,0 +1,85 @@
+/*********************************************************************
+ *  Author  : Himangshu Saikia
+ *  Init    : Saturday, October 17, 2026 - 16:10:37
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#pragma once
+
+#include <labraytracer/labraytracermoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <labraytracer/rayintersection.h>
+
+namespace inviwo {
+
+/** \class HitBatch
+    \brief Structure-of-arrays of ray hits for batch shading.
+
+    Holds the position, the (not necessarily normalized) surface normal and the ray
+    direction of every hit in separate float arrays, so that shading loops can run over
+    contiguous memory.
+
+    @author Himangshu Saikia
+*/
+struct HitBatch {
+    std::vector<float> px, py, pz;
+    std::vector<float> nx, ny, nz;
+    std::vector<float> vx, vy, vz;
+
+    size_t size() const { return px.size(); }
+
+    void clear() {
+        for (auto* v : {&px, &py, &pz, &nx, &ny, &nz, &vx, &vy, &vz}) v->clear();
+    }
+
+    void reserve(size_t n) {
+        for (auto* v : {&px, &py, &pz, &nx, &ny, &nz, &vx, &vy, &vz}) v->reserve(n);
+    }
+
+    void push(const vec3& position, const vec3& normal, const vec3& direction) {
+        px.push_back(position.x);
+        py.push_back(position.y);
+        pz.push_back(position.z);
+        nx.push_back(normal.x);
+        ny.push_back(normal.y);
+        nz.push_back(normal.z);
+        vx.push_back(direction.x);
+        vy.push_back(direction.y);
+        vz.push_back(direction.z);
+    }
+
+    void push(const RayIntersection& intersection) {
+        push(intersection.getPosition(), intersection.getNormal(),
+             intersection.getRay().getDirection());
+    }
+};
+
+/** \class ShadeScratch
+    \brief Per-hit working arrays of batch shading.
+
+    Owned by the caller and passed to every call, so that shading a batch does not allocate
+    once the arrays have grown to the largest batch.
+
+    @author Himangshu Saikia
+*/
+struct ShadeScratch {
+    // Normalized normals and view directions
+    std::vector<float> nx, ny, nz, vx, vy, vz;
+    // Per-light terms
+    std::vector<float> diffuse, specular, distanceSq;
+    // Sum over the lights
+    std::vector<float> r, g, b;
+
+    void resize(size_t n) {
+        for (auto* v : {&nx, &ny, &nz, &vx, &vy, &vz, &diffuse, &specular, &distanceSq, &r, &g,
+                        &b}) {
+            v->resize(n);
+        }
+    }
+};
+
+}  // namespace inviwo
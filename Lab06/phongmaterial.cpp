@@ -10,9 +10,156 @@
 
 #include <labraytracer/phongmaterial.h>
 #include <labraytracer/util.h>
+#include <labraytracer/cpufeatures.h>
+#include <algorithm>
+#include <cmath>
+
+#if defined(LABRAYTRACER_X86)
+#include <immintrin.h>
+#endif
 
 namespace inviwo {
 
+namespace {
+constexpr float AmbientStrength = 0.005f;
+
+#if defined(LABRAYTRACER_X86)
+/*  Normalizes the first multiple of eight of the n vectors, returns how many it did.
+*/
+LABRAYTRACER_TARGET_AVX
+size_t normalizeAllAVX(size_t n, const float* x, const float* y, const float* z, float* outX,
+                       float* outY, float* outZ) {
+    size_t i = 0;
+    const __m256 one = _mm256_set1_ps(1.0f);
+    for (; i + 8 <= n; i += 8) {
+        const __m256 vx = _mm256_loadu_ps(x + i);
+        const __m256 vy = _mm256_loadu_ps(y + i);
+        const __m256 vz = _mm256_loadu_ps(z + i);
+        const __m256 lengthSq = _mm256_add_ps(
+            _mm256_add_ps(_mm256_mul_ps(vx, vx), _mm256_mul_ps(vy, vy)), _mm256_mul_ps(vz, vz));
+        const __m256 invLength = _mm256_div_ps(one, _mm256_sqrt_ps(lengthSq));
+        _mm256_storeu_ps(outX + i, _mm256_mul_ps(vx, invLength));
+        _mm256_storeu_ps(outY + i, _mm256_mul_ps(vy, invLength));
+        _mm256_storeu_ps(outZ + i, _mm256_mul_ps(vz, invLength));
+    }
+    return i;
+}
+#endif
+
+/*  Normalizes the n vectors (x[i], y[i], z[i]) into (outX[i], outY[i], outZ[i]).
+*/
+void normalizeAll(size_t n, const float* x, const float* y, const float* z, float* outX,
+                  float* outY, float* outZ) {
+    size_t i = 0;
+#if defined(LABRAYTRACER_X86)
+    if (Kernel::simdLevel() >= Kernel::SimdLevel::AVX) {
+        i = normalizeAllAVX(n, x, y, z, outX, outY, outZ);
+    }
+#endif
+    for (; i < n; i++) {
+        const float invLength = 1.0f / std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+        outX[i] = x[i] * invLength;
+        outY[i] = y[i] * invLength;
+        outZ[i] = z[i] * invLength;
+    }
+}
+
+#if defined(LABRAYTRACER_X86)
+/*  lightTerms() for the first multiple of eight of the hits, returns how many it did.
+*/
+LABRAYTRACER_TARGET_AVX
+size_t lightTermsAVX(const HitBatch& hits, const vec3& lightPos, ShadeScratch& scratch) {
+    const size_t n = hits.size();
+    size_t i = 0;
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 two = _mm256_set1_ps(2.0f);
+    for (; i + 8 <= n; i += 8) {
+        const __m256 dx = _mm256_sub_ps(_mm256_set1_ps(lightPos.x), _mm256_loadu_ps(&hits.px[i]));
+        const __m256 dy = _mm256_sub_ps(_mm256_set1_ps(lightPos.y), _mm256_loadu_ps(&hits.py[i]));
+        const __m256 dz = _mm256_sub_ps(_mm256_set1_ps(lightPos.z), _mm256_loadu_ps(&hits.pz[i]));
+        const __m256 distanceSq = _mm256_add_ps(
+            _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+        const __m256 invDistance = _mm256_div_ps(one, _mm256_sqrt_ps(distanceSq));
+        const __m256 lx = _mm256_mul_ps(dx, invDistance);
+        const __m256 ly = _mm256_mul_ps(dy, invDistance);
+        const __m256 lz = _mm256_mul_ps(dz, invDistance);
+
+        // cosNL uses the normal as given, T1 the normalized one, like shade()
+        const __m256 cosNL = _mm256_max_ps(
+            _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(&hits.nx[i]), lx),
+                                        _mm256_mul_ps(_mm256_loadu_ps(&hits.ny[i]), ly)),
+                          _mm256_mul_ps(_mm256_loadu_ps(&hits.nz[i]), lz)),
+            zero);
+        const __m256 nx = _mm256_loadu_ps(&scratch.nx[i]);
+        const __m256 ny = _mm256_loadu_ps(&scratch.ny[i]);
+        const __m256 nz = _mm256_loadu_ps(&scratch.nz[i]);
+        const __m256 T1 = _mm256_max_ps(
+            _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(nx, lx), _mm256_mul_ps(ny, ly)),
+                          _mm256_mul_ps(nz, lz)),
+            zero);
+        const __m256 twoT1 = _mm256_mul_ps(two, T1);
+        const __m256 rx = _mm256_sub_ps(lx, _mm256_mul_ps(twoT1, nx));
+        const __m256 ry = _mm256_sub_ps(ly, _mm256_mul_ps(twoT1, ny));
+        const __m256 rz = _mm256_sub_ps(lz, _mm256_mul_ps(twoT1, nz));
+        const __m256 invLengthR = _mm256_div_ps(
+            one, _mm256_sqrt_ps(_mm256_add_ps(
+                     _mm256_add_ps(_mm256_mul_ps(rx, rx), _mm256_mul_ps(ry, ry)),
+                     _mm256_mul_ps(rz, rz))));
+        const __m256 T2 = _mm256_max_ps(
+            _mm256_mul_ps(
+                _mm256_add_ps(
+                    _mm256_add_ps(_mm256_mul_ps(rx, _mm256_loadu_ps(&scratch.vx[i])),
+                                  _mm256_mul_ps(ry, _mm256_loadu_ps(&scratch.vy[i]))),
+                    _mm256_mul_ps(rz, _mm256_loadu_ps(&scratch.vz[i]))),
+                invLengthR),
+            zero);
+
+        _mm256_storeu_ps(&scratch.diffuse[i], _mm256_div_ps(cosNL, distanceSq));
+        _mm256_storeu_ps(&scratch.specular[i], T2);
+        _mm256_storeu_ps(&scratch.distanceSq[i], distanceSq);
+    }
+    return i;
+}
+#endif
+
+/*  Diffuse term cosNL / distance^2, the specular base max(R.V, 0) and the squared distance
+    to the light for all hits, as in PhongMaterial::shade().
+*/
+void lightTerms(const HitBatch& hits, const vec3& lightPos, ShadeScratch& scratch) {
+    const size_t n = hits.size();
+    size_t i = 0;
+#if defined(LABRAYTRACER_X86)
+    if (Kernel::simdLevel() >= Kernel::SimdLevel::AVX) i = lightTermsAVX(hits, lightPos, scratch);
+#endif
+    for (; i < n; i++) {
+        const float dx = lightPos.x - hits.px[i];
+        const float dy = lightPos.y - hits.py[i];
+        const float dz = lightPos.z - hits.pz[i];
+        const float distanceSq = dx * dx + dy * dy + dz * dz;
+        const float invDistance = 1.0f / std::sqrt(distanceSq);
+        const float lx = dx * invDistance;
+        const float ly = dy * invDistance;
+        const float lz = dz * invDistance;
+
+        const float cosNL = std::max(hits.nx[i] * lx + hits.ny[i] * ly + hits.nz[i] * lz, 0.0f);
+        const float nx = scratch.nx[i], ny = scratch.ny[i], nz = scratch.nz[i];
+        const float T1 = std::max(nx * lx + ny * ly + nz * lz, 0.0f);
+        const float rx = lx - 2.0f * T1 * nx;
+        const float ry = ly - 2.0f * T1 * ny;
+        const float rz = lz - 2.0f * T1 * nz;
+        const float invLengthR = 1.0f / std::sqrt(rx * rx + ry * ry + rz * rz);
+        const float T2 = std::max(
+            (rx * scratch.vx[i] + ry * scratch.vy[i] + rz * scratch.vz[i]) * invLengthR, 0.0f);
+
+        scratch.diffuse[i] = cosNL / distanceSq;
+        scratch.specular[i] = T2;
+        scratch.distanceSq[i] = distanceSq;
+    }
+}
+
+}  // namespace
+
 PhongMaterial::PhongMaterial(const vec3& color, const double reflectance, const double shininess,
     const vec3& ambientMaterialColor, const vec3& diffuseMaterialColor, const vec3& specularMaterialColor) 
     : Material(color, reflectance) {
@@ -68,45 +215,79 @@ vec4 PhongMaterial::shade(const RayIntersection& intersection, const Light& ligh
 
     // distance
     vec3 distanceVec = light.getPosition() - intersection.getPosition(); //this is pos_light - pos_object
-    double distance = length(distanceVec);
-    double attentuation = glm::pow(distance, 2);
-    float ambientStrength = 0.005;
+    const double distanceSq = dot(distanceVec, distanceVec);
 
-    
     vec3 normN = Util::normalize(N);
-    vec3 N2 = Util::scalarMult(2, normN);  // scalar multiplication of normalized N
-
     double T1 = std::max(double(dot(normN, L)), double(0.0)); //get maximum value from the dot product between normalized N and L vectors
-    vec3 R0 = Util::scalarMult(T1, N2); //scalar multiplication between t1 and N2
+    vec3 normR = Util::normalize(L - Util::scalarMult(2 * T1, normN)); //reflection vector
+    vec3 normV = Util::normalize(intersection.getRay().getDirection());
+    double T2 = std::max(double(dot(normR, normV)), double(0.0));
 
-    vec3 R = - (R0 - L);
-    vec3 normR = Util::normalize(R);
+    // Light falloff and the specular exponent are the same for all three channels
+    const float diffuseFactor = static_cast<float>(cosNL / distanceSq);
+    const float specularFactor = static_cast<float>(glm::pow(T2, shininess_) / distanceSq);
 
-    vec3 V = intersection.getRay().getDirection();
-    vec3 normV = Util::normalize(V);
+    vec3 ambiC = AmbientStrength * ambientMaterialColor_ * light.getAmbientColor(); //ambient part
+    vec3 specC = specularFactor * specularMaterialColor_ * light.getSpecularColor(); // Specular (glossy) part
+    vec3 diffC = diffuseFactor * diffuseMaterialColor_ * light.getDiffuseColor(); // Diffuse part
 
-    double T2 = std::max(double(dot(normR, normV)), double(0.0));
+    vec3 sumC = (ambiC + specC + diffC); // sum both diffuse and specular color components //color
 
-    //ambient part
-    vec3 ambiC = vec3(ambientStrength * ambientMaterialColor_[0] * light.getAmbientColor()[0], //we dive and multiply three times as we use an RGB model
-                      ambientStrength * ambientMaterialColor_[1] * light.getAmbientColor()[1],
-                      ambientStrength * ambientMaterialColor_[2] * light.getAmbientColor()[2]);
+    return vec4(sumC, 1.0);
+    //return vec4(Util::scalarMult(cosNL, this->color()), 1.0);
+}
 
-    // Specular (glossy) part
-    vec3 specC = vec3(specularMaterialColor_[0] * light.getSpecularColor()[0] * glm::pow(T2, shininess_) / attentuation, //we dive and multiply three times as we use an RGB model
-                      specularMaterialColor_[1] * light.getSpecularColor()[1] * glm::pow(T2, shininess_) / attentuation,  
-                      specularMaterialColor_[2] * light.getSpecularColor()[2] * glm::pow(T2, shininess_) / attentuation);
+void PhongMaterial::shadeBatch(const HitBatch& hits, const std::vector<Light>& lights,
+                               ShadeScratch& scratch, vec4* colors) const {
+    const size_t n = hits.size();
+    scratch.resize(n);
 
-    // Diffuse part
-    vec3 diffC = vec3((diffuseMaterialColor_[0] * light.getDiffuseColor()[0] * cosNL) / attentuation, //we dive and multiply three times as we use an RGB model
-                      (diffuseMaterialColor_[1] * light.getDiffuseColor()[1] * cosNL) / attentuation,
-                      (diffuseMaterialColor_[2] * light.getDiffuseColor()[2] * cosNL) / attentuation);
+    // Per-hit terms that do not depend on the light
+    normalizeAll(n, hits.nx.data(), hits.ny.data(), hits.nz.data(), scratch.nx.data(),
+                 scratch.ny.data(), scratch.nz.data());
+    normalizeAll(n, hits.vx.data(), hits.vy.data(), hits.vz.data(), scratch.vx.data(),
+                 scratch.vy.data(), scratch.vz.data());
+    std::fill(scratch.r.begin(), scratch.r.end(), 0.0f);
+    std::fill(scratch.g.begin(), scratch.g.end(), 0.0f);
+    std::fill(scratch.b.begin(), scratch.b.end(), 0.0f);
 
+    const double shininess = shininess_;
+    for (const Light& light : lights) {
+        // Same terms as shade(), one light at a time over all hits
+        lightTerms(hits, light.getPosition(), scratch);
+        for (size_t i = 0; i < n; i++) {
+            scratch.specular[i] =
+                static_cast<float>(std::pow(double(scratch.specular[i]), shininess) /
+                                   scratch.distanceSq[i]);
+        }
 
-    vec3 sumC = (ambiC + specC + diffC); // sum both diffuse and specular color components //color
+        const vec3 ambient = AmbientStrength * ambientMaterialColor_ * light.getAmbientColor();
+        const vec3 diffuseColor = diffuseMaterialColor_ * light.getDiffuseColor();
+        const vec3 specularColor = specularMaterialColor_ * light.getSpecularColor();
+        for (size_t i = 0; i < n; i++) {
+            scratch.r[i] += ambient.r + scratch.diffuse[i] * diffuseColor.r +
+                            scratch.specular[i] * specularColor.r;
+            scratch.g[i] += ambient.g + scratch.diffuse[i] * diffuseColor.g +
+                            scratch.specular[i] * specularColor.g;
+            scratch.b[i] += ambient.b + scratch.diffuse[i] * diffuseColor.b +
+                            scratch.specular[i] * specularColor.b;
+        }
+    }
 
-    return vec4(sumC, 1.0);
-    //return vec4(Util::scalarMult(cosNL, this->color()), 1.0);
+    // shade() has an alpha of one, so the sum over the lights has one per light
+    const float alpha = static_cast<float>(lights.size());
+    for (size_t i = 0; i < n; i++) {
+        colors[i] = vec4(scratch.r[i], scratch.g[i], scratch.b[i], alpha);
+    }
+}
+
+void PhongMaterial::addToSignature(SceneSignature& signature) const {
+    signature.add(color());
+    signature.add(reflectance());
+    signature.add(shininess_);
+    signature.add(ambientMaterialColor_);
+    signature.add(diffuseMaterialColor_);
+    signature.add(specularMaterialColor_);
 }
 
 } // namespace
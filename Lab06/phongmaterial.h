@@ -13,6 +13,8 @@
 #include <labraytracer/labraytracermoduledefine.h>
 #include <inviwo/core/common/inviwo.h>
 #include <labraytracer/material.h>
+#include <labraytracer/scenesignature.h>
+#include <labraytracer/hitbatch.h>
 
 namespace inviwo {
 
@@ -40,6 +42,15 @@ public:
     //Methods
 public:
     vec4 shade(const RayIntersection& intersection, const Light& light) const override;
+
+    /// Shades all hits of the batch and writes the sum over all lights to colors, which must
+    /// hold hits.size() entries. Per hit, this equals summing shade() over the lights up to
+    /// float rounding, including an alpha of one per light. The geometric terms are computed
+    /// eight hits at a time with AVX on CPUs that have it (see Kernel::simdLevel()), the
+    /// specular power is a scalar std::pow.
+    void shadeBatch(const HitBatch& hits, const std::vector<Light>& lights,
+                    ShadeScratch& scratch, vec4* colors) const;
+    void addToSignature(SceneSignature& signature) const override;
     //Attributes
 public:
     double shininess_;
@@ -0,0 +1,61 @@
+/*********************************************************************
+ *  Author  : Himangshu Saikia
+ *  Init    : Saturday, October 17, 2026 - 15:05:52
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#pragma once
+
+#include <labraytracer/labraytracermoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <cstdint>
+#include <cstring>
+
+namespace inviwo {
+
+/** \class SceneSignature
+    \brief Hash over the parameters of everything that influences the rendered image.
+
+    Renderables and materials add their parameters, the processor adds the camera.
+    Two frames with equal signatures render the same image, which lets the progressive
+    mode keep accumulating samples even if the scene objects were recreated.
+
+    @author Himangshu Saikia
+*/
+class SceneSignature {
+    //Methods
+public:
+    void add(uint64_t value) {
+        // FNV-1a over the bytes of the value
+        for (int i(0); i < 8; i++) {
+            hash_ ^= (value >> (8 * i)) & 0xff;
+            hash_ *= 0x100000001b3ull;
+        }
+    }
+
+    void add(double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        add(bits);
+    }
+
+    void add(float value) { add(double(value)); }
+
+    void add(const vec3& value) {
+        add(value.x);
+        add(value.y);
+        add(value.z);
+    }
+
+    uint64_t get() const { return hash_; }
+
+    //Attributes
+private:
+    uint64_t hash_ = 0xcbf29ce484222325ull;
+};
+
+}  // namespace inviwo
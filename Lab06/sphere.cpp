@@ -10,15 +10,38 @@
 
 #include <labraytracer/sphere.h>
 #include <labraytracer/util.h>
+#include <labraytracer/spherekernel.h>
+#include <cmath>
 
 namespace inviwo {
 
+namespace {
+
+/*  Kernel::intersectSphere for rays of any direction. The kernel needs a unit direction, so
+    other directions are normalized and lambda is scaled back to the parameter of the ray.
+*/
+bool intersectRay(const Ray& ray, const vec3& center, float radiusSq, float& lambda) {
+    const vec3& dir = ray.getDirection();
+    const float lengthSq = dot(dir, dir);
+    if (lengthSq == 1.0f) {
+        return Kernel::intersectSphere(ray.getOrigin(), dir, center, radiusSq, lambda);
+    }
+    const float length = std::sqrt(lengthSq);
+    if (!Kernel::intersectSphere(ray.getOrigin(), dir / length, center, radiusSq, lambda)) {
+        return false;
+    }
+    lambda /= length;
+    return true;
+}
+
+}  // namespace
+
 Sphere::Sphere(const vec3& center, const double& radius, const vec3& center2, const double& radius2) {
     center_ = center;
     radius_ = radius;
     center2_ = center2;
     radius2_ = radius2;
-
+    radiusSq_ = static_cast<float>(radius * radius);
 }
 
 bool Sphere::closestIntersection(const Ray& ray, double maxLambda,
@@ -34,45 +57,18 @@ bool Sphere::closestIntersection(const Ray& ray, double maxLambda,
     // If you need the intersection point, use ray.pointOnRay(lambda)
     // You can ignore the uvw (texture coordinates)
 
-    //compute the intersection between a ray and a sphere;
-    //define ray
-    const vec3 X = ray.getOrigin(); //set ray origin
-    const vec3 D = ray.getDirection(); //set get direction
-    const vec3 C = center_;
-    float r = radius_;
-
-    //define sphere
-    float x = dot(D, D); //dot product of the direction of the ray
-    float d = 2 * dot(D, X - C); //𝜆2(𝐭𝑟⋅𝐩𝑟)
-    float c = dot((X - C), (X - C)) - r * r; //<𝐱(𝜆)−𝐜,𝐱𝜆−𝐜>−𝑟2=0, implicit sphere
-
-    //define equation for the lambda
-    float equat = d * d - 4 * x * c;
-
-    if (equat < 0.00) {  // if equation function is not positive, return false
+    // Nearest root in front of the ray origin, see Kernel::intersectSphere
+    float lambda;
+    if (!intersectRay(ray, center_, radiusSq_, lambda)) {
         return false;
     }
 
-    float firstLambda = ((-d + sqrt(equat)) / 2 * x);
-    float secondLambda = ((-d - sqrt(equat)) / 2 * x);
-    float lambda; //ray parameter(dynamic variable)
-
-    if (firstLambda >= 0.00 && secondLambda <= 0.00) {  // if lambda 1 is positive, take the positive one
-        lambda = firstLambda;
-    } else if (secondLambda >= 0.00 && firstLambda <= 0.00) {  // if lamb2 is positive and lamb1 negative, take the positive one
-        lambda = secondLambda;
-    } else if (firstLambda >= 0.00 && secondLambda >= 0.00) {  // if both values are bigger than 0,
-        lambda = std::min(firstLambda, secondLambda); // get minimum positive value from the both
-    } else {
-        return false; //if any option contemplated before, return false
-    }
-
     if (Util::epsilon + lambda > maxLambda) {  // if epsilon is bigger than the manimum lambda value, return false
         return false; 
     }
 
     const vec3 p = ray.pointOnRay(lambda); // pointing in the location where ray hits sphere
-    const vec3 n = p - C; // normal vector
+    const vec3 n = p - center_; // normal vector
     const vec3 uvw(0, 0, 0); // Texture Coordinate System in 3D Environments (modeling) vector  
 
     //Reference in the form of a smart pointer to the Object with which the intersection occurred.
@@ -81,8 +77,23 @@ bool Sphere::closestIntersection(const Ray& ray, double maxLambda,
 }
 
 bool Sphere::anyIntersection(const Ray& ray, double maxLambda) const {
-    RayIntersection temp;
-    return closestIntersection(ray, maxLambda, temp);
+    // Occlusion only: same hit decision as closestIntersection, for any ray direction, but
+    // neither the normal nor the intersection record (and its shared_from_this() handle)
+    // are built.
+    float lambda;
+    return intersectRay(ray, center_, radiusSq_, lambda) && Util::epsilon + lambda <= maxLambda;
+}
+
+AABB Sphere::getBoundingBox() const {
+    const vec3 r(static_cast<float>(radius_));
+    return AABB(center_ - r, center_ + r);
+}
+
+void Sphere::addToSignature(SceneSignature& signature) const {
+    signature.add(center_);
+    signature.add(radius_);
+    signature.add(center2_);
+    signature.add(radius2_);
 }
 
 void Sphere::drawGeometry(std::shared_ptr<BasicMesh> mesh,
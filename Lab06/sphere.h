@@ -13,12 +13,18 @@
 #include <labraytracer/labraytracermoduledefine.h>
 #include <inviwo/core/common/inviwo.h>
 #include <labraytracer/renderable.h>
+#include <labraytracer/aabb.h>
+#include <labraytracer/scenesignature.h>
 
 namespace inviwo {
 
 /** \class Sphere
     \brief Sphere defined by a center point and a radius.
 
+    The intersection queries accept rays of any direction and report lambda in the
+    parameter of the ray. The single-precision kernel behind them needs a unit direction,
+    so other rays are normalized first and cost one more square root.
+
     @author Himangshu Saikia
 */
 class IVW_MODULE_LABRAYTRACER_API Sphere : public Renderable {
@@ -37,6 +43,8 @@ public:
     bool closestIntersection(const Ray& ray, double maxLambda, RayIntersection& intersection) const
     override;
     bool anyIntersection(const Ray& ray, double maxLambda) const override;
+    AABB getBoundingBox() const override;
+    void addToSignature(SceneSignature& signature) const override;
     void drawGeometry(std::shared_ptr<BasicMesh> mesh,
                       std::vector<BasicMesh::Vertex>& vertices) const override;
     //Attributes
@@ -45,6 +53,7 @@ private:
     double radius_;
     vec3 center2_;
     double radius2_;
+    float radiusSq_;
 };
 
 } // namespace
@@ -0,0 +1,199 @@
+/*********************************************************************
+ *  Author  : Himangshu Saikia
+ *  Init    : Saturday, October 17, 2026 - 17:48:09
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#include <labraytracer/spherekernel.h>
+#include <labraytracer/cpufeatures.h>
+#include <cmath>
+
+#if defined(LABRAYTRACER_X86)
+#include <immintrin.h>
+#endif
+
+// Scalar and packet kernels must round identically, so multiplies and adds are never fused
+#if defined(__clang__)
+#pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#elif defined(_MSC_VER)
+#pragma fp_contract(off)
+#endif
+
+namespace inviwo {
+
+namespace Kernel {
+
+bool intersectSphere(const vec3& origin, const vec3& dir, const vec3& center, float radiusSq,
+                     float& lambda) {
+    const float ocx = origin.x - center.x;
+    const float ocy = origin.y - center.y;
+    const float ocz = origin.z - center.z;
+
+    const float b = ocx * dir.x + ocy * dir.y + ocz * dir.z;
+    const float fx = ocx - b * dir.x;
+    const float fy = ocy - b * dir.y;
+    const float fz = ocz - b * dir.z;
+    const float discriminant = radiusSq - (fx * fx + fy * fy + fz * fz);
+    if (!(discriminant >= 0.0f)) return false;
+
+    const float c = (ocx * ocx + ocy * ocy + ocz * ocz) - radiusSq;
+    const float q = -b - std::copysign(std::sqrt(discriminant), b);
+    const float t0 = c / q;
+    const float t1 = q;
+    const float tNear = t0 < t1 ? t0 : t1;
+    const float tFar = t0 > t1 ? t0 : t1;
+
+    lambda = tNear >= 0.0f ? tNear : tFar;
+    return lambda >= 0.0f;
+}
+
+namespace {
+
+int closestLane(int mask, const float* lambdas, float& lambda) {
+    int best = -1;
+    for (int lane(0); lane < SpherePacket::Width; lane++) {
+        if ((mask & (1 << lane)) && (best < 0 || lambdas[lane] < lambdas[best])) best = lane;
+    }
+    if (best >= 0) lambda = lambdas[best];
+    return best;
+}
+
+#if defined(LABRAYTRACER_X86)
+
+LABRAYTRACER_TARGET_AVX
+int intersect8(const SpherePacket& packet, const vec3& origin, const vec3& dir, float maxLambda,
+               float* lambdas) {
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+
+    const __m256 dx = _mm256_set1_ps(dir.x);
+    const __m256 dy = _mm256_set1_ps(dir.y);
+    const __m256 dz = _mm256_set1_ps(dir.z);
+    const __m256 radiusSq = _mm256_load_ps(packet.radiusSq);
+
+    const __m256 ocx = _mm256_sub_ps(_mm256_set1_ps(origin.x), _mm256_load_ps(packet.cx));
+    const __m256 ocy = _mm256_sub_ps(_mm256_set1_ps(origin.y), _mm256_load_ps(packet.cy));
+    const __m256 ocz = _mm256_sub_ps(_mm256_set1_ps(origin.z), _mm256_load_ps(packet.cz));
+
+    const __m256 b = _mm256_add_ps(
+        _mm256_add_ps(_mm256_mul_ps(ocx, dx), _mm256_mul_ps(ocy, dy)), _mm256_mul_ps(ocz, dz));
+    const __m256 fx = _mm256_sub_ps(ocx, _mm256_mul_ps(b, dx));
+    const __m256 fy = _mm256_sub_ps(ocy, _mm256_mul_ps(b, dy));
+    const __m256 fz = _mm256_sub_ps(ocz, _mm256_mul_ps(b, dz));
+    const __m256 discriminant = _mm256_sub_ps(
+        radiusSq, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(fx, fx), _mm256_mul_ps(fy, fy)),
+                                _mm256_mul_ps(fz, fz)));
+    __m256 valid = _mm256_cmp_ps(discriminant, zero, _CMP_GE_OQ);
+
+    const __m256 c = _mm256_sub_ps(
+        _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ocx, ocx), _mm256_mul_ps(ocy, ocy)),
+                      _mm256_mul_ps(ocz, ocz)),
+        radiusSq);
+    // copysign(sqrt(discriminant), b); lanes with a negative discriminant are masked out
+    const __m256 s = _mm256_or_ps(_mm256_and_ps(b, signMask),
+                                  _mm256_andnot_ps(signMask, _mm256_sqrt_ps(discriminant)));
+    const __m256 q = _mm256_sub_ps(_mm256_xor_ps(b, signMask), s);
+    const __m256 t0 = _mm256_div_ps(c, q);
+    const __m256 t1 = q;
+    // minps/maxps return the second operand on unordered input, like the scalar ternaries
+    const __m256 tNear = _mm256_min_ps(t0, t1);
+    const __m256 tFar = _mm256_max_ps(t0, t1);
+    const __m256 t = _mm256_blendv_ps(tFar, tNear, _mm256_cmp_ps(tNear, zero, _CMP_GE_OQ));
+
+    valid = _mm256_and_ps(valid, _mm256_cmp_ps(t, zero, _CMP_GE_OQ));
+    valid = _mm256_and_ps(valid, _mm256_cmp_ps(t, _mm256_set1_ps(maxLambda), _CMP_LE_OQ));
+
+    _mm256_storeu_ps(lambdas, t);
+    return _mm256_movemask_ps(valid);
+}
+
+LABRAYTRACER_TARGET_SSE2
+int intersect4(const SpherePacket& packet, int offset, const vec3& origin, const vec3& dir,
+               float maxLambda, float* lambdas) {
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+
+    const __m128 dx = _mm_set1_ps(dir.x);
+    const __m128 dy = _mm_set1_ps(dir.y);
+    const __m128 dz = _mm_set1_ps(dir.z);
+    const __m128 radiusSq = _mm_load_ps(packet.radiusSq + offset);
+
+    const __m128 ocx = _mm_sub_ps(_mm_set1_ps(origin.x), _mm_load_ps(packet.cx + offset));
+    const __m128 ocy = _mm_sub_ps(_mm_set1_ps(origin.y), _mm_load_ps(packet.cy + offset));
+    const __m128 ocz = _mm_sub_ps(_mm_set1_ps(origin.z), _mm_load_ps(packet.cz + offset));
+
+    const __m128 b =
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(ocx, dx), _mm_mul_ps(ocy, dy)), _mm_mul_ps(ocz, dz));
+    const __m128 fx = _mm_sub_ps(ocx, _mm_mul_ps(b, dx));
+    const __m128 fy = _mm_sub_ps(ocy, _mm_mul_ps(b, dy));
+    const __m128 fz = _mm_sub_ps(ocz, _mm_mul_ps(b, dz));
+    const __m128 discriminant = _mm_sub_ps(
+        radiusSq,
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(fx, fx), _mm_mul_ps(fy, fy)), _mm_mul_ps(fz, fz)));
+    __m128 valid = _mm_cmpge_ps(discriminant, zero);
+
+    const __m128 c = _mm_sub_ps(
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(ocx, ocx), _mm_mul_ps(ocy, ocy)), _mm_mul_ps(ocz, ocz)),
+        radiusSq);
+    const __m128 s =
+        _mm_or_ps(_mm_and_ps(b, signMask), _mm_andnot_ps(signMask, _mm_sqrt_ps(discriminant)));
+    const __m128 q = _mm_sub_ps(_mm_xor_ps(b, signMask), s);
+    const __m128 t0 = _mm_div_ps(c, q);
+    const __m128 t1 = q;
+    const __m128 tNear = _mm_min_ps(t0, t1);
+    const __m128 tFar = _mm_max_ps(t0, t1);
+    // SSE2 has no blend, select with and/andnot
+    const __m128 nearInFront = _mm_cmpge_ps(tNear, zero);
+    const __m128 t = _mm_or_ps(_mm_and_ps(nearInFront, tNear), _mm_andnot_ps(nearInFront, tFar));
+
+    valid = _mm_and_ps(valid, _mm_cmpge_ps(t, zero));
+    valid = _mm_and_ps(valid, _mm_cmple_ps(t, _mm_set1_ps(maxLambda)));
+
+    _mm_storeu_ps(lambdas + offset, t);
+    return _mm_movemask_ps(valid) << offset;
+}
+
+#endif
+
+}  // namespace
+
+int intersectSpherePacket(const SpherePacket& packet, const vec3& origin, const vec3& dir,
+                          float maxLambda, float& lambda) {
+#if defined(LABRAYTRACER_X86)
+    const SimdLevel level = simdLevel();
+    if (level != SimdLevel::Scalar) {
+        float lambdas[SpherePacket::Width];
+        int mask = (level == SimdLevel::AVX)
+                       ? intersect8(packet, origin, dir, maxLambda, lambdas)
+                       : intersect4(packet, 0, origin, dir, maxLambda, lambdas) |
+                             intersect4(packet, 4, origin, dir, maxLambda, lambdas);
+        mask &= (1 << packet.count) - 1;
+        return closestLane(mask, lambdas, lambda);
+    }
+#endif
+    return intersectSpherePacketScalar(packet, origin, dir, maxLambda, lambda);
+}
+
+int intersectSpherePacketScalar(const SpherePacket& packet, const vec3& origin, const vec3& dir,
+                                float maxLambda, float& lambda) {
+    float lambdas[SpherePacket::Width];
+    int mask = 0;
+    for (int lane(0); lane < packet.count; lane++) {
+        const vec3 center(packet.cx[lane], packet.cy[lane], packet.cz[lane]);
+        if (intersectSphere(origin, dir, center, packet.radiusSq[lane], lambdas[lane]) &&
+            lambdas[lane] <= maxLambda) {
+            mask |= 1 << lane;
+        }
+    }
+    return closestLane(mask, lambdas, lambda);
+}
+
+}  // namespace Kernel
+
+}  // namespace inviwo
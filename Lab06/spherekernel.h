@@ -0,0 +1,80 @@
+/*********************************************************************
+ *  Author  : Himangshu Saikia
+ *  Init    : Saturday, October 17, 2026 - 17:48:09
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#pragma once
+
+#include <labraytracer/labraytracermoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+namespace inviwo {
+
+namespace Kernel {
+
+/*  Ray/sphere test for a normalized ray direction, in single precision.
+
+    Uses the half-b form of the quadratic, t^2 + 2bt + c = 0, with one square root. The
+    discriminant is computed as r^2 - |oc - b*dir|^2 rather than b^2 - c, and the smaller
+    root as c/q, which avoids the cancellation of the textbook formula for spheres that are
+    far away or small compared to their distance.
+
+    On success, lambda is the nearest root that is not behind the ray origin.
+
+    All arithmetic is spelled out in the same order as the packet kernel, and
+    spherekernel.cpp is compiled without contracting multiplies and adds into FMA
+    instructions. Scalar and packet kernel therefore round identically and give bit-identical
+    hit decisions and lambda, also for rays that graze the silhouette or end at maxLambda.
+*/
+IVW_MODULE_LABRAYTRACER_API bool intersectSphere(const vec3& origin, const vec3& dir,
+                                                 const vec3& center, float radiusSq,
+                                                 float& lambda);
+
+/** \class SpherePacket
+    \brief Eight spheres in structure-of-arrays layout for the packet kernel.
+
+    Unused lanes have a negative squared radius, so they never hit.
+
+    @author Himangshu Saikia
+*/
+struct IVW_MODULE_LABRAYTRACER_API SpherePacket {
+    static constexpr int Width = 8;
+
+    alignas(32) float cx[Width] = {};
+    alignas(32) float cy[Width] = {};
+    alignas(32) float cz[Width] = {};
+    alignas(32) float radiusSq[Width] = {-1, -1, -1, -1, -1, -1, -1, -1};
+    int count = 0;
+
+    void set(int lane, const vec3& center, float radius) {
+        cx[lane] = center.x;
+        cy[lane] = center.y;
+        cz[lane] = center.z;
+        radiusSq[lane] = radius * radius;
+    }
+};
+
+/*  Tests one ray with normalized direction against all spheres of the packet at once, with
+    AVX or SSE2 lanes as chosen by Kernel::simdLevel(), and with the scalar kernel on other
+    CPUs.
+
+    Returns the lane of the closest hit in [0, maxLambda] or -1. Ties go to the lower lane.
+*/
+IVW_MODULE_LABRAYTRACER_API int intersectSpherePacket(const SpherePacket& packet,
+                                                      const vec3& origin, const vec3& dir,
+                                                      float maxLambda, float& lambda);
+
+/*  Scalar reference implementation of intersectSpherePacket.
+*/
+IVW_MODULE_LABRAYTRACER_API int intersectSpherePacketScalar(const SpherePacket& packet,
+                                                            const vec3& origin, const vec3& dir,
+                                                            float maxLambda, float& lambda);
+
+}  // namespace Kernel
+
+}  // namespace inviwo
@@ -0,0 +1,61 @@
+/*********************************************************************
+ *  Author  : Himangshu Saikia
+ *  Init    : Sunday, October 18, 2026 - 09:14:52
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <labraytracer/aabb.h>
+
+namespace inviwo {
+
+namespace {
+
+bool hits(const AABB& box, const vec3& origin, const vec3& dir, float& tNear) {
+    return box.intersect(origin, vec3(1.0f) / dir, 100.0, tNear);
+}
+
+}  // namespace
+
+TEST(AABB, HitsAndMisses) {
+    const AABB box(vec3(-1.0f), vec3(1.0f));
+    float tNear;
+    EXPECT_TRUE(hits(box, vec3(-3.0f, 0.2f, 0.3f), vec3(1.0f, 0.0f, 0.0f), tNear));
+    EXPECT_FLOAT_EQ(tNear, 2.0f);
+    EXPECT_FALSE(hits(box, vec3(-3.0f, 2.0f, 0.3f), vec3(1.0f, 0.0f, 0.0f), tNear));
+    EXPECT_FALSE(hits(box, vec3(3.0f, 0.2f, 0.3f), vec3(1.0f, 0.0f, 0.0f), tNear));
+    EXPECT_TRUE(hits(box, vec3(0.0f), vec3(0.0f, 0.0f, -1.0f), tNear));
+    EXPECT_FLOAT_EQ(tNear, 0.0f);
+}
+
+/*  Axis-aligned rays that start on a face plane and run inside that face. The zero
+    direction components make 0 * inf = NaN in the slab test, for both signs of zero.
+*/
+TEST(AABB, RaysInsideFacePlanesHit) {
+    const AABB box(vec3(-1.0f), vec3(1.0f));
+    float tNear;
+    for (const float zero : {0.0f, -0.0f}) {
+        // On the lower and upper x face, travelling along z towards the box
+        EXPECT_TRUE(hits(box, vec3(-1.0f, 0.5f, -3.0f), vec3(zero, zero, 1.0f), tNear));
+        EXPECT_FLOAT_EQ(tNear, 2.0f);
+        EXPECT_TRUE(hits(box, vec3(1.0f, 0.5f, -3.0f), vec3(zero, zero, 1.0f), tNear));
+        EXPECT_FLOAT_EQ(tNear, 2.0f);
+
+        // Along an edge of the box
+        EXPECT_TRUE(hits(box, vec3(1.0f, -1.0f, 3.0f), vec3(zero, zero, -1.0f), tNear));
+        EXPECT_FLOAT_EQ(tNear, 2.0f);
+
+        // In the face plane, but beside the face
+        EXPECT_FALSE(hits(box, vec3(-1.0f, 1.5f, -3.0f), vec3(zero, zero, 1.0f), tNear));
+    }
+}
+
+}  // namespace inviwo
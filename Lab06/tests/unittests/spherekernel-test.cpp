@@ -0,0 +1,160 @@
+/*********************************************************************
+ *  Author  : Himangshu Saikia
+ *  Init    : Saturday, October 17, 2026 - 17:48:09
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <labraytracer/spherekernel.h>
+#include <labraytracer/cpufeatures.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+/*  The instruction sets of this CPU, each of which the packet kernel has to match the scalar
+    kernel with. Restores the supported level when done.
+*/
+struct SimdLevels {
+    std::vector<Kernel::SimdLevel> levels;
+    SimdLevels() {
+        for (auto level : {Kernel::SimdLevel::Scalar, Kernel::SimdLevel::SSE2,
+                           Kernel::SimdLevel::AVX}) {
+            if (level <= Kernel::supportedSimdLevel()) levels.push_back(level);
+        }
+    }
+    ~SimdLevels() { Kernel::setSimdLevel(Kernel::supportedSimdLevel()); }
+};
+
+/*  Packet and scalar kernel must give bit-identical results on every instruction set.
+*/
+void expectIdentical(const Kernel::SpherePacket& packet, const vec3& origin, const vec3& dir,
+                     float maxLambda, const SimdLevels& simd, int test, int& numHits) {
+    float lambdaScalar = 0;
+    const int laneScalar =
+        Kernel::intersectSpherePacketScalar(packet, origin, dir, maxLambda, lambdaScalar);
+    if (laneScalar >= 0) numHits++;
+    for (auto level : simd.levels) {
+        Kernel::setSimdLevel(level);
+        float lambdaPacket = 0;
+        const int lanePacket =
+            Kernel::intersectSpherePacket(packet, origin, dir, maxLambda, lambdaPacket);
+        ASSERT_EQ(lanePacket, laneScalar) << "test " << test << ", level " << int(level);
+        if (laneScalar < 0) continue;
+        EXPECT_EQ(lambdaPacket, lambdaScalar) << "test " << test << ", level " << int(level);
+    }
+}
+
+}  // namespace
+
+/*  Rays pass a sphere of the packet clearly inside or outside of its silhouette.
+*/
+TEST(SphereKernel, PacketMatchesScalar) {
+    const SimdLevels simd;
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> position(-4.0f, 4.0f);
+    std::uniform_real_distribution<float> radius(0.1f, 1.0f);
+    std::uniform_real_distribution<float> inside(0.0f, 0.99f);
+    std::uniform_real_distribution<float> outside(1.01f, 2.0f);
+
+    int numHits = 0;
+    for (int test(0); test < 2000; test++) {
+        Kernel::SpherePacket packet;
+        packet.count = 1 + test % Kernel::SpherePacket::Width;
+        vec3 centers[Kernel::SpherePacket::Width];
+        float radii[Kernel::SpherePacket::Width];
+        for (int lane(0); lane < packet.count; lane++) {
+            centers[lane] = vec3(position(rng), position(rng), position(rng));
+            radii[lane] = radius(rng);
+            packet.set(lane, centers[lane], radii[lane]);
+        }
+
+        // Aim past the target sphere, sideways to the ray, by a fraction of its radius
+        const int target = test % packet.count;
+        const vec3 origin(position(rng), position(rng), 12.0f);
+        const vec3 toCenter = glm::normalize(centers[target] - origin);
+        const vec3 side = glm::normalize(glm::cross(toCenter, vec3(1, 0, 0)));
+        const float offset = (test % 2 == 0 ? inside(rng) : outside(rng)) * radii[target];
+        const vec3 dir = glm::normalize(centers[target] + offset * side - origin);
+
+        expectIdentical(packet, origin, dir, 1e30f, simd, test, numHits);
+    }
+    // Both outcomes have to be covered
+    EXPECT_GT(numHits, 500);
+    EXPECT_LT(numHits, 1900);
+}
+
+/*  Rays aimed at the silhouette of a sphere, where rounding decides between hit and miss,
+    some of them starting inside the sphere or right on it. Hits are repeated with maxLambda
+    equal to the hit distance and just below it.
+*/
+TEST(SphereKernel, GrazingRaysMatchScalarExactly) {
+    const SimdLevels simd;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> position(-4.0f, 4.0f);
+    std::uniform_real_distribution<float> radius(0.1f, 1.0f);
+    std::uniform_real_distribution<float> jitter(-1e-6f, 1e-6f);
+
+    int numHits = 0, numRays = 0;
+    for (int test(0); test < 4000; test++) {
+        Kernel::SpherePacket packet;
+        packet.count = Kernel::SpherePacket::Width;
+        vec3 centers[Kernel::SpherePacket::Width];
+        float radii[Kernel::SpherePacket::Width];
+        for (int lane(0); lane < packet.count; lane++) {
+            centers[lane] = vec3(position(rng), position(rng), position(rng));
+            radii[lane] = radius(rng);
+            packet.set(lane, centers[lane], radii[lane]);
+        }
+
+        const int target = test % packet.count;
+        vec3 origin(position(rng), position(rng), 12.0f);
+        const vec3 toCenter = glm::normalize(centers[target] - origin);
+        const vec3 side = glm::normalize(glm::cross(toCenter, vec3(1, 0, 0)));
+        vec3 dir = glm::normalize(centers[target] + radii[target] * (1.0f + jitter(rng)) * side -
+                                  origin);
+        if (test % 5 == 0) {
+            // Start on the sphere surface, facing outwards or inwards
+            origin = centers[target] + radii[target] * side;
+            dir = glm::normalize(test % 2 == 0 ? side : -side);
+        }
+
+        float lambda;
+        const int lane = Kernel::intersectSpherePacketScalar(packet, origin, dir, 1e30f, lambda);
+        expectIdentical(packet, origin, dir, 1e30f, simd, test, numHits);
+        numRays++;
+        if (lane < 0) continue;
+        expectIdentical(packet, origin, dir, lambda, simd, test, numHits);
+        expectIdentical(packet, origin, dir, std::nextafter(lambda, 0.0f), simd, test, numHits);
+        numRays += 2;
+    }
+    // Rounding has to decide both ways
+    EXPECT_GT(numHits, numRays / 10);
+    EXPECT_LT(numHits, numRays - numRays / 10);
+}
+
+TEST(SphereKernel, OriginInsideHitsFarRoot) {
+    Kernel::SpherePacket packet;
+    packet.set(0, vec3(0, 0, 0), 2.0f);
+    packet.count = 1;
+
+    float lambda = 0;
+    EXPECT_EQ(Kernel::intersectSpherePacket(packet, vec3(0, 0, 1), vec3(0, 0, 1), 10.0f, lambda),
+              0);
+    EXPECT_FLOAT_EQ(lambda, 1.0f);
+    EXPECT_EQ(Kernel::intersectSpherePacket(packet, vec3(0, 0, 1), vec3(0, 0, 1), 0.5f, lambda),
+              -1);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,63 @@
+/*********************************************************************
+ *  Author  : Himangshu Saikia
+ *  Init    : Sunday, October 18, 2026 - 10:14:36
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <labraytracer/tiledrenderer.h>
+#include <stdexcept>
+#include <vector>
+
+namespace inviwo {
+
+TEST(TiledRenderer, WritesEveryPixelOnce) {
+    const size2_t resolution(37, 21);
+    std::vector<vec4> pixels(resolution.x * resolution.y, vec4(0));
+    TiledRenderer renderer(8, 4);
+    renderer.render(resolution, pixels.data(), [](size_t x, size_t y) {
+        return vec4(float(x), float(y), 1, 1);
+    });
+    for (size_t y(0); y < resolution.y; y++) {
+        for (size_t x(0); x < resolution.x; x++) {
+            const vec4& pixel = pixels[y * resolution.x + x];
+            EXPECT_EQ(pixel.x, float(x));
+            EXPECT_EQ(pixel.y, float(y));
+        }
+    }
+}
+
+/*  The throwing pixel lies in a tile of the calling thread and of a worker thread in turn.
+*/
+TEST(TiledRenderer, RethrowsExceptionsOfAllWorkers) {
+    const size2_t resolution(64, 64);
+    std::vector<vec4> pixels(resolution.x * resolution.y);
+    TiledRenderer renderer(8, 4);
+    for (const size2_t bad : {size2_t(0, 0), size2_t(63, 63), size2_t(20, 40)}) {
+        EXPECT_THROW(renderer.render(resolution, pixels.data(),
+                                     [&](size_t x, size_t y) {
+                                         if (x == bad.x && y == bad.y) {
+                                             throw std::runtime_error("shade failed");
+                                         }
+                                         return vec4(1);
+                                     }),
+                     std::runtime_error);
+    }
+
+    // Exceptions from the progress callback as well
+    EXPECT_THROW(renderer.render(resolution, pixels.data(), [](size_t, size_t) { return vec4(1); },
+                                 [](const TiledRenderer::Tile&, size_t numTilesDone, size_t) {
+                                     if (numTilesDone == 10) throw std::runtime_error("cancel");
+                                 }),
+                 std::runtime_error);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,176 @@
+/*********************************************************************
+ *  Author  : Himangshu Saikia
+ *  Init    : Saturday, October 17, 2026 - 11:02:47
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <labraytracer/trianglekernel.h>
+#include <labraytracer/cpufeatures.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+/*  The instruction sets of this CPU, each of which the packet kernel has to match the scalar
+    kernel with. Restores the supported level when done.
+*/
+struct SimdLevels {
+    std::vector<Kernel::SimdLevel> levels;
+    SimdLevels() {
+        for (auto level : {Kernel::SimdLevel::Scalar, Kernel::SimdLevel::SSE2,
+                           Kernel::SimdLevel::AVX}) {
+            if (level <= Kernel::supportedSimdLevel()) levels.push_back(level);
+        }
+    }
+    ~SimdLevels() { Kernel::setSimdLevel(Kernel::supportedSimdLevel()); }
+};
+
+struct PacketHit {
+    int lane = -1;
+    float lambda = 0, u = 0, v = 0;
+};
+
+/*  Packet and scalar kernel must give bit-identical results on every instruction set.
+*/
+void expectIdentical(const Kernel::TrianglePacket& packet, const vec3& origin, const vec3& dir,
+                     float maxLambda, const SimdLevels& simd, int test, int& numHits) {
+    PacketHit scalar;
+    scalar.lane = Kernel::intersectTrianglePacketScalar(packet, origin, dir, maxLambda,
+                                                        scalar.lambda, scalar.u, scalar.v);
+    if (scalar.lane >= 0) numHits++;
+    for (auto level : simd.levels) {
+        Kernel::setSimdLevel(level);
+        PacketHit hit;
+        hit.lane = Kernel::intersectTrianglePacket(packet, origin, dir, maxLambda, hit.lambda,
+                                                   hit.u, hit.v);
+        ASSERT_EQ(hit.lane, scalar.lane) << "test " << test << ", level " << int(level);
+        if (scalar.lane < 0) continue;
+        EXPECT_EQ(hit.lambda, scalar.lambda) << "test " << test << ", level " << int(level);
+        EXPECT_EQ(hit.u, scalar.u) << "test " << test << ", level " << int(level);
+        EXPECT_EQ(hit.v, scalar.v) << "test " << test << ", level " << int(level);
+    }
+}
+
+}  // namespace
+
+/*  Rays are aimed at barycentric points clearly inside or outside a triangle of the packet.
+*/
+TEST(TriangleKernel, PacketMatchesScalar) {
+    const SimdLevels simd;
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> position(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> inside(0.01f, 0.49f);
+    std::uniform_real_distribution<float> outside(0.01f, 0.5f);
+
+    int numHits = 0;
+    for (int test(0); test < 2000; test++) {
+        Kernel::TrianglePacket packet;
+        packet.count = 1 + test % Kernel::TrianglePacket::Width;
+        vec3 p0[Kernel::TrianglePacket::Width], p1[Kernel::TrianglePacket::Width],
+            p2[Kernel::TrianglePacket::Width];
+        for (int lane(0); lane < packet.count; lane++) {
+            p0[lane] = vec3(position(rng), position(rng), position(rng));
+            p1[lane] = vec3(position(rng), position(rng), position(rng));
+            p2[lane] = vec3(position(rng), position(rng), position(rng));
+            packet.set(lane, p0[lane], p1[lane] - p0[lane], p2[lane] - p0[lane]);
+        }
+
+        const int target = test % packet.count;
+        float u = inside(rng), v = inside(rng);
+        if (test % 3 == 0) u = -outside(rng);
+        if (test % 5 == 0) v = 1.0f - u + outside(rng);
+        const vec3 aim = p0[target] + u * (p1[target] - p0[target]) + v * (p2[target] - p0[target]);
+        const vec3 origin(position(rng) * 4.0f, position(rng) * 4.0f, 5.0f);
+        const vec3 dir = glm::normalize(aim - origin);
+
+        expectIdentical(packet, origin, dir, 1e30f, simd, test, numHits);
+    }
+    // Both outcomes have to be covered
+    EXPECT_GT(numHits, 500);
+    EXPECT_LT(numHits, 1900);
+}
+
+/*  Rays aimed exactly at edges and vertices, some of them shared by two triangles of the
+    packet, where rounding decides between hit and miss. Hits are repeated with maxLambda
+    equal to the hit distance and just below it.
+*/
+TEST(TriangleKernel, GrazingRaysMatchScalarExactly) {
+    const SimdLevels simd;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> position(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> along(0.0f, 1.0f);
+
+    int numHits = 0, numRays = 0;
+    for (int test(0); test < 4000; test++) {
+        Kernel::TrianglePacket packet;
+        packet.count = Kernel::TrianglePacket::Width;
+        vec3 p0[Kernel::TrianglePacket::Width], p1[Kernel::TrianglePacket::Width],
+            p2[Kernel::TrianglePacket::Width];
+        for (int lane(0); lane < packet.count; lane++) {
+            p0[lane] = vec3(position(rng), position(rng), position(rng));
+            p1[lane] = vec3(position(rng), position(rng), position(rng));
+            p2[lane] = vec3(position(rng), position(rng), position(rng));
+            // Every other triangle shares the edge p1 p2 of its predecessor, as in a mesh
+            if (lane % 2 == 1) {
+                p0[lane] = p2[lane - 1];
+                p1[lane] = p1[lane - 1];
+            }
+            packet.set(lane, p0[lane], p1[lane] - p0[lane], p2[lane] - p0[lane]);
+        }
+
+        const int target = test % packet.count;
+        const float s = (test % 7 == 0) ? 0.0f : along(rng);
+        vec3 aim;
+        switch (test % 3) {
+            case 0: aim = p0[target] + s * (p1[target] - p0[target]); break;
+            case 1: aim = p0[target] + s * (p2[target] - p0[target]); break;
+            default: aim = p1[target] + s * (p2[target] - p1[target]); break;
+        }
+        const vec3 origin(position(rng) * 4.0f, position(rng) * 4.0f, 5.0f);
+        const vec3 dir = glm::normalize(aim - origin);
+
+        float lambda, u, v;
+        const int lane =
+            Kernel::intersectTrianglePacketScalar(packet, origin, dir, 1e30f, lambda, u, v);
+        expectIdentical(packet, origin, dir, 1e30f, simd, test, numHits);
+        numRays++;
+        if (lane < 0) continue;
+        expectIdentical(packet, origin, dir, lambda, simd, test, numHits);
+        expectIdentical(packet, origin, dir, std::nextafter(lambda, 0.0f), simd, test, numHits);
+        numRays += 2;
+    }
+    // Rounding has to decide both ways
+    EXPECT_GT(numHits, numRays / 10);
+    EXPECT_LT(numHits, numRays - numRays / 10);
+}
+
+TEST(TriangleKernel, EmptyLanesNeverHit) {
+    Kernel::TrianglePacket packet;
+    packet.set(0, vec3(-1, -1, 0), vec3(2, 0, 0), vec3(0, 2, 0));
+    packet.count = 1;
+
+    float lambda = 0, u = 0, v = 0;
+    EXPECT_EQ(Kernel::intersectTrianglePacket(packet, vec3(0.5f, 0.5f, 1), vec3(0, 0, -1), 10.0f,
+                                              lambda, u, v),
+              -1);
+    EXPECT_EQ(Kernel::intersectTrianglePacket(packet, vec3(-0.5f, -0.5f, 1), vec3(0, 0, -1),
+                                              10.0f, lambda, u, v),
+              0);
+    EXPECT_FLOAT_EQ(lambda, 1.0f);
+    EXPECT_FLOAT_EQ(u, 0.25f);
+    EXPECT_FLOAT_EQ(v, 0.25f);
+}
+
+}  // namespace inviwo
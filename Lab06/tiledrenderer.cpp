@@ -0,0 +1,140 @@
+/*********************************************************************
+ *  Author  : Himangshu Saikia
+ *  Init    : Saturday, October 17, 2026 - 14:21:18
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#include <labraytracer/tiledrenderer.h>
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace inviwo {
+
+namespace {
+
+/*  Tile queue of one worker. The owner takes tiles from the front, thieves from the back,
+    so that the owner keeps working on neighbouring tiles as long as possible.
+*/
+class TileQueue {
+public:
+    void push(size_t tile) { tiles_.push_back(tile); }
+
+    bool pop(size_t& tile) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (tiles_.empty()) return false;
+        tile = tiles_.front();
+        tiles_.pop_front();
+        return true;
+    }
+
+    bool steal(size_t& tile) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (tiles_.empty()) return false;
+        tile = tiles_.back();
+        tiles_.pop_back();
+        return true;
+    }
+
+private:
+    std::mutex mutex_;
+    std::deque<size_t> tiles_;
+};
+
+}  // namespace
+
+TiledRenderer::TiledRenderer(size_t tileSize, size_t numThreads)
+    : tileSize_(std::max<size_t>(tileSize, 1)), numThreads_(numThreads) {}
+
+void TiledRenderer::setTileSize(size_t tileSize) { tileSize_ = std::max<size_t>(tileSize, 1); }
+
+void TiledRenderer::setNumThreads(size_t numThreads) { numThreads_ = numThreads; }
+
+size_t TiledRenderer::getNumThreads() const {
+    if (numThreads_ > 0) return numThreads_;
+    return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+void TiledRenderer::render(const size2_t& resolution, vec4* pixels, const PixelFunction& shade,
+                           const TileCallback& onTileDone) const {
+    const size_t numTilesX = (resolution.x + tileSize_ - 1) / tileSize_;
+    const size_t numTilesY = (resolution.y + tileSize_ - 1) / tileSize_;
+    const size_t numTiles = numTilesX * numTilesY;
+    if (numTiles == 0) return;
+
+    auto getTile = [&](size_t index) {
+        Tile tile;
+        tile.index = index;
+        tile.origin = size2_t((index % numTilesX) * tileSize_, (index / numTilesX) * tileSize_);
+        tile.size = size2_t(std::min(tileSize_, resolution.x - tile.origin.x),
+                            std::min(tileSize_, resolution.y - tile.origin.y));
+        return tile;
+    };
+
+    const size_t numWorkers = std::min(getNumThreads(), numTiles);
+
+    // Hand out contiguous runs of tiles for locality; stealing balances the rest
+    std::vector<TileQueue> queues(numWorkers);
+    for (size_t i(0); i < numTiles; i++) {
+        queues[i * numWorkers / numTiles].push(i);
+    }
+
+    std::mutex progressMutex;
+    size_t numTilesDone = 0;
+
+    // The first exception of any worker stops all of them and is rethrown after the join
+    std::mutex errorMutex;
+    std::exception_ptr error;
+    std::atomic<bool> failed{false};
+
+    auto renderTiles = [&](size_t worker) {
+        size_t index;
+        while (!failed.load(std::memory_order_relaxed)) {
+            bool found = queues[worker].pop(index);
+            for (size_t k(1); !found && k < numWorkers; k++) {
+                found = queues[(worker + k) % numWorkers].steal(index);
+            }
+            if (!found) return;
+
+            const Tile tile = getTile(index);
+            for (size_t y(tile.origin.y); y < tile.origin.y + tile.size.y; y++) {
+                for (size_t x(tile.origin.x); x < tile.origin.x + tile.size.x; x++) {
+                    pixels[y * resolution.x + x] = shade(x, y);
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(progressMutex);
+            numTilesDone++;
+            if (onTileDone) onTileDone(tile, numTilesDone, numTiles);
+        }
+    };
+
+    auto work = [&](size_t worker) {
+        try {
+            renderTiles(worker);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) error = std::current_exception();
+            failed = true;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(numWorkers - 1);
+    for (size_t worker(1); worker < numWorkers; worker++) {
+        threads.emplace_back(work, worker);
+    }
+    // The calling thread is worker zero
+    work(0);
+    for (auto& thread : threads) thread.join();
+    if (error) std::rethrow_exception(error);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,74 @@
+/*********************************************************************
+ *  Author  : Himangshu Saikia
+ *  Init    : Saturday, October 17, 2026 - 14:21:18
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#pragma once
+
+#include <labraytracer/labraytracermoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <functional>
+
+namespace inviwo {
+
+/** \class TiledRenderer
+    \brief Renders an image in square tiles spread over several worker threads.
+
+    The image is cut into tiles of tileSize x tileSize pixels. Every worker starts with a
+    contiguous run of tiles and, once it runs dry, steals tiles from the back of the other
+    workers' queues. Every pixel is written exactly once by the pixel function, so the
+    image does not depend on how the tiles were scheduled as long as the pixel function
+    itself is deterministic and thread-safe.
+
+    @author Himangshu Saikia
+*/
+class IVW_MODULE_LABRAYTRACER_API TiledRenderer {
+    //Friends
+    //Types
+public:
+    struct Tile {
+        size2_t origin;
+        size2_t size;
+        size_t index;
+    };
+
+    /// Computes the color of pixel (x, y). Called concurrently from all workers.
+    using PixelFunction = std::function<vec4(size_t x, size_t y)>;
+
+    /// Called after a tile has been written, with the number of finished tiles so far.
+    /// Calls are serialized, so the callback does not need to be thread-safe.
+    using TileCallback = std::function<void(const Tile& tile, size_t numTilesDone, size_t numTiles)>;
+
+    //Construction / Deconstruction
+public:
+    /// A thread count of zero uses all hardware threads.
+    TiledRenderer(size_t tileSize = 16, size_t numThreads = 0);
+    virtual ~TiledRenderer() = default;
+
+    //Methods
+public:
+    void setTileSize(size_t tileSize);
+    size_t getTileSize() const { return tileSize_; }
+    void setNumThreads(size_t numThreads);
+    size_t getNumThreads() const;
+
+    /* Renders resolution.x * resolution.y pixels into the row-major array pixels.
+       If the pixel function or the callback throws, the workers stop after their current
+       tile, all threads are joined, and the first exception is rethrown to the caller.
+       The image is then only partially written.
+    */
+    void render(const size2_t& resolution, vec4* pixels, const PixelFunction& shade,
+                const TileCallback& onTileDone = nullptr) const;
+
+    //Attributes
+private:
+    size_t tileSize_;
+    size_t numThreads_;
+};
+
+}  // namespace inviwo
@@ -10,6 +10,8 @@
 
 #include <labraytracer/triangle.h>
 #include <labraytracer/util.h>
+#include <labraytracer/trianglekernel.h>
+#include <limits>
 #include <memory>
 
 namespace inviwo {
@@ -24,83 +26,51 @@ Triangle::Triangle(const vec3& v0, const vec3& v1, const vec3& v2, const vec3& u
     mUVW[0] = uvw0;
     mUVW[1] = uvw1;
     mUVW[2] = uvw2;
-}
-
-
 
+    // Precompute the edge data used by the intersection kernel
+    mEdges[0] = v1 - v0;
+    mEdges[1] = v2 - v0;
+    mNormal = glm::normalize(glm::cross(mEdges[0], mEdges[1]));
+}
 
 bool Triangle::closestIntersection(const Ray& ray, double maxLambda,
                                    RayIntersection& intersection) const {
-    // Programming TASK 1: Implement this method
-    // Your code should compute the intersection between a ray and a triangle.
-    //
-    // If you detect an intersection, the return type should look similar to this:
-    // if(rayIntersectsTriangle)
-    //{
-    //  intersection = RayIntersection(ray,shared_from_this(),lambda,ray.normal,uvw);
-    //  return true;
-    //}
-    //
-    // Hints :
-    // Ray origin p_r : ray.getOrigin()
-    // Ray direction t_r : ray.getDirection()
-    // Compute the intersection point using ray.pointOnRay(lambda)
-
-    
-
-    vec3 tr = ray.getDirection();
-    vec3 pr = ray.getOrigin();
-    vec3 uvw(0, 0, 0);
-
-    vec3 p0 = mVertices[0];
-    vec3 p1 = mVertices[1];
-    vec3 p2 = mVertices[2];
-
-    //Lecture 08 - Raytracing
-    //Page 18 Ray-Triangle intersection
-    vec3 t1 = p1 - p0;
-    vec3 t2 = p2 - p0;
-
-    // n=t1xt2
-    vec3 n = glm::normalize(glm::cross(t1, t2));
-
-    double lambda = -1;
-
-    // lambda = (p0-pr) x n/(tr x n)
-    // page 17. In practice tr x n > epsilon
-    if (fabs(dot(tr, n)) > Util::epsilon) {
-        lambda = dot(p0 - pr, n) / dot(tr, n);
-    } 
-    else
-        return false;
-
-    if (lambda < 0 || lambda > maxLambda) {
+    // Moeller-Trumbore on the precomputed edges, see Kernel::intersectTriangle
+    const float maxLambdaF =
+        static_cast<float>(std::min(maxLambda, double(std::numeric_limits<float>::max())));
+    float lambda, u, v;
+    if (!Kernel::intersectTriangle(ray.getOrigin(), ray.getDirection(), mVertices[0], mEdges[0],
+                                   mEdges[1], maxLambdaF, lambda, u, v)) {
         return false;
     }
 
-    vec3 p = ray.pointOnRay(lambda);
-
-    //check if point inside triangle geometrically
-    //https://ppt-online.org/703109 slide 25 (University of Virginia 445)
-    vec3 cp1 = cross(p2 - p1, p - p1);
-    vec3 cp2 = cross(p2 - p1, p0 - p1);
-    vec3 cp3 = cross(p2 - p0, p - p0);
-    vec3 cp4 = cross(p2 - p0, p1 - p0);
-    vec3 cp5 = cross(p1 - p0, p - p0);
-    vec3 cp6 = cross(p1 - p0, p2 - p0);
-    if (dot(cp1, cp2) < 0) return false;
-    if (dot(cp3, cp4) < 0) return false;
-    if (dot(cp5, cp6) < 0) return false;
-
-        
-    intersection = RayIntersection(ray, shared_from_this(), lambda, ray.pointOnRay(lambda), uvw);
+    const vec3 uvw = (1.0f - u - v) * mUVW[0] + u * mUVW[1] + v * mUVW[2];
+    intersection = RayIntersection(ray, shared_from_this(), lambda, mNormal, uvw);
     return true;
-
 }
 
 bool Triangle::anyIntersection(const Ray& ray, double maxLambda) const {
-    RayIntersection temp;
-    return closestIntersection(ray, maxLambda, temp);
+    // Occlusion only: no intersection record, hence no shared_from_this() handle
+    const float maxLambdaF =
+        static_cast<float>(std::min(maxLambda, double(std::numeric_limits<float>::max())));
+    float lambda, u, v;
+    return Kernel::intersectTriangle(ray.getOrigin(), ray.getDirection(), mVertices[0],
+                                     mEdges[0], mEdges[1], maxLambdaF, lambda, u, v);
+}
+
+AABB Triangle::getBoundingBox() const {
+    AABB box;
+    box.extend(mVertices[0]);
+    box.extend(mVertices[1]);
+    box.extend(mVertices[2]);
+    return box;
+}
+
+void Triangle::addToSignature(SceneSignature& signature) const {
+    for (int i(0); i < 3; i++) {
+        signature.add(mVertices[i]);
+        signature.add(mUVW[i]);
+    }
 }
 
 void Triangle::drawGeometry(std::shared_ptr<BasicMesh> mesh,
@@ -0,0 +1,255 @@
+/*********************************************************************
+ *  Author  : Himangshu Saikia
+ *  Init    : Saturday, October 17, 2026 - 11:02:47
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#include <labraytracer/trianglekernel.h>
+#include <labraytracer/cpufeatures.h>
+#include <cmath>
+
+#if defined(LABRAYTRACER_X86)
+#include <immintrin.h>
+#endif
+
+// Scalar and packet kernels must round identically, so multiplies and adds are never fused
+#if defined(__clang__)
+#pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#elif defined(_MSC_VER)
+#pragma fp_contract(off)
+#endif
+
+namespace inviwo {
+
+namespace Kernel {
+
+bool intersectTriangle(const vec3& origin, const vec3& dir, const vec3& p0, const vec3& e1,
+                       const vec3& e2, float maxLambda, float& lambda, float& u, float& v) {
+    // pvec = dir x e2
+    const float px = dir.y * e2.z - dir.z * e2.y;
+    const float py = dir.z * e2.x - dir.x * e2.z;
+    const float pz = dir.x * e2.y - dir.y * e2.x;
+
+    const float det = e1.x * px + e1.y * py + e1.z * pz;
+    if (!(std::abs(det) >= TriangleDetEpsilon)) return false;
+    const float invDet = 1.0f / det;
+
+    const float tx = origin.x - p0.x;
+    const float ty = origin.y - p0.y;
+    const float tz = origin.z - p0.z;
+
+    u = (tx * px + ty * py + tz * pz) * invDet;
+    if (!(u >= 0.0f && u <= 1.0f)) return false;
+
+    // qvec = tvec x e1
+    const float qx = ty * e1.z - tz * e1.y;
+    const float qy = tz * e1.x - tx * e1.z;
+    const float qz = tx * e1.y - ty * e1.x;
+
+    v = (dir.x * qx + dir.y * qy + dir.z * qz) * invDet;
+    if (!(v >= 0.0f && u + v <= 1.0f)) return false;
+
+    lambda = (e2.x * qx + e2.y * qy + e2.z * qz) * invDet;
+    return lambda >= 0.0f && lambda <= maxLambda;
+}
+
+void TrianglePacket::set(int lane, const vec3& p0, const vec3& e1, const vec3& e2) {
+    p0x[lane] = p0.x;
+    p0y[lane] = p0.y;
+    p0z[lane] = p0.z;
+    e1x[lane] = e1.x;
+    e1y[lane] = e1.y;
+    e1z[lane] = e1.z;
+    e2x[lane] = e2.x;
+    e2y[lane] = e2.y;
+    e2z[lane] = e2.z;
+}
+
+namespace {
+
+/*  Picks the closest lane out of a hit mask. Ties go to the lower lane.
+*/
+int closestLane(int mask, const float* lambdas, const float* us, const float* vs, float& lambda,
+                float& u, float& v) {
+    int best = -1;
+    for (int lane(0); lane < TrianglePacket::Width; lane++) {
+        if ((mask & (1 << lane)) && (best < 0 || lambdas[lane] < lambdas[best])) best = lane;
+    }
+    if (best >= 0) {
+        lambda = lambdas[best];
+        u = us[best];
+        v = vs[best];
+    }
+    return best;
+}
+
+#if defined(LABRAYTRACER_X86)
+
+LABRAYTRACER_TARGET_AVX
+int intersect8(const TrianglePacket& packet, const vec3& origin, const vec3& dir, float maxLambda,
+               float* lambdas, float* us, float* vs) {
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+
+    const __m256 dx = _mm256_set1_ps(dir.x);
+    const __m256 dy = _mm256_set1_ps(dir.y);
+    const __m256 dz = _mm256_set1_ps(dir.z);
+
+    const __m256 e1x = _mm256_load_ps(packet.e1x);
+    const __m256 e1y = _mm256_load_ps(packet.e1y);
+    const __m256 e1z = _mm256_load_ps(packet.e1z);
+    const __m256 e2x = _mm256_load_ps(packet.e2x);
+    const __m256 e2y = _mm256_load_ps(packet.e2y);
+    const __m256 e2z = _mm256_load_ps(packet.e2z);
+
+    const __m256 px = _mm256_sub_ps(_mm256_mul_ps(dy, e2z), _mm256_mul_ps(dz, e2y));
+    const __m256 py = _mm256_sub_ps(_mm256_mul_ps(dz, e2x), _mm256_mul_ps(dx, e2z));
+    const __m256 pz = _mm256_sub_ps(_mm256_mul_ps(dx, e2y), _mm256_mul_ps(dy, e2x));
+
+    const __m256 det = _mm256_add_ps(
+        _mm256_add_ps(_mm256_mul_ps(e1x, px), _mm256_mul_ps(e1y, py)), _mm256_mul_ps(e1z, pz));
+    const __m256 absDet = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), det);
+    __m256 valid = _mm256_cmp_ps(absDet, _mm256_set1_ps(TriangleDetEpsilon), _CMP_GE_OQ);
+    const __m256 invDet = _mm256_div_ps(one, det);
+
+    const __m256 tx = _mm256_sub_ps(_mm256_set1_ps(origin.x), _mm256_load_ps(packet.p0x));
+    const __m256 ty = _mm256_sub_ps(_mm256_set1_ps(origin.y), _mm256_load_ps(packet.p0y));
+    const __m256 tz = _mm256_sub_ps(_mm256_set1_ps(origin.z), _mm256_load_ps(packet.p0z));
+
+    const __m256 u = _mm256_mul_ps(
+        _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(tx, px), _mm256_mul_ps(ty, py)),
+                      _mm256_mul_ps(tz, pz)),
+        invDet);
+    valid = _mm256_and_ps(valid, _mm256_cmp_ps(u, zero, _CMP_GE_OQ));
+    valid = _mm256_and_ps(valid, _mm256_cmp_ps(u, one, _CMP_LE_OQ));
+
+    const __m256 qx = _mm256_sub_ps(_mm256_mul_ps(ty, e1z), _mm256_mul_ps(tz, e1y));
+    const __m256 qy = _mm256_sub_ps(_mm256_mul_ps(tz, e1x), _mm256_mul_ps(tx, e1z));
+    const __m256 qz = _mm256_sub_ps(_mm256_mul_ps(tx, e1y), _mm256_mul_ps(ty, e1x));
+
+    const __m256 v = _mm256_mul_ps(
+        _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, qx), _mm256_mul_ps(dy, qy)),
+                      _mm256_mul_ps(dz, qz)),
+        invDet);
+    valid = _mm256_and_ps(valid, _mm256_cmp_ps(v, zero, _CMP_GE_OQ));
+    valid = _mm256_and_ps(valid, _mm256_cmp_ps(_mm256_add_ps(u, v), one, _CMP_LE_OQ));
+
+    const __m256 t = _mm256_mul_ps(
+        _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e2x, qx), _mm256_mul_ps(e2y, qy)),
+                      _mm256_mul_ps(e2z, qz)),
+        invDet);
+    valid = _mm256_and_ps(valid, _mm256_cmp_ps(t, zero, _CMP_GE_OQ));
+    valid = _mm256_and_ps(valid, _mm256_cmp_ps(t, _mm256_set1_ps(maxLambda), _CMP_LE_OQ));
+
+    _mm256_storeu_ps(lambdas, t);
+    _mm256_storeu_ps(us, u);
+    _mm256_storeu_ps(vs, v);
+    return _mm256_movemask_ps(valid);
+}
+
+LABRAYTRACER_TARGET_SSE2
+int intersect4(const TrianglePacket& packet, int offset, const vec3& origin, const vec3& dir,
+               float maxLambda, float* lambdas, float* us, float* vs) {
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    const __m128 dx = _mm_set1_ps(dir.x);
+    const __m128 dy = _mm_set1_ps(dir.y);
+    const __m128 dz = _mm_set1_ps(dir.z);
+
+    const __m128 e1x = _mm_load_ps(packet.e1x + offset);
+    const __m128 e1y = _mm_load_ps(packet.e1y + offset);
+    const __m128 e1z = _mm_load_ps(packet.e1z + offset);
+    const __m128 e2x = _mm_load_ps(packet.e2x + offset);
+    const __m128 e2y = _mm_load_ps(packet.e2y + offset);
+    const __m128 e2z = _mm_load_ps(packet.e2z + offset);
+
+    const __m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+    const __m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+    const __m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+
+    const __m128 det =
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+    const __m128 absDet = _mm_andnot_ps(_mm_set1_ps(-0.0f), det);
+    __m128 valid = _mm_cmpge_ps(absDet, _mm_set1_ps(TriangleDetEpsilon));
+    const __m128 invDet = _mm_div_ps(one, det);
+
+    const __m128 tx = _mm_sub_ps(_mm_set1_ps(origin.x), _mm_load_ps(packet.p0x + offset));
+    const __m128 ty = _mm_sub_ps(_mm_set1_ps(origin.y), _mm_load_ps(packet.p0y + offset));
+    const __m128 tz = _mm_sub_ps(_mm_set1_ps(origin.z), _mm_load_ps(packet.p0z + offset));
+
+    const __m128 u = _mm_mul_ps(
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, px), _mm_mul_ps(ty, py)), _mm_mul_ps(tz, pz)),
+        invDet);
+    valid = _mm_and_ps(valid, _mm_cmpge_ps(u, zero));
+    valid = _mm_and_ps(valid, _mm_cmple_ps(u, one));
+
+    const __m128 qx = _mm_sub_ps(_mm_mul_ps(ty, e1z), _mm_mul_ps(tz, e1y));
+    const __m128 qy = _mm_sub_ps(_mm_mul_ps(tz, e1x), _mm_mul_ps(tx, e1z));
+    const __m128 qz = _mm_sub_ps(_mm_mul_ps(tx, e1y), _mm_mul_ps(ty, e1x));
+
+    const __m128 v = _mm_mul_ps(
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)),
+        invDet);
+    valid = _mm_and_ps(valid, _mm_cmpge_ps(v, zero));
+    valid = _mm_and_ps(valid, _mm_cmple_ps(_mm_add_ps(u, v), one));
+
+    const __m128 t = _mm_mul_ps(
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)),
+        invDet);
+    valid = _mm_and_ps(valid, _mm_cmpge_ps(t, zero));
+    valid = _mm_and_ps(valid, _mm_cmple_ps(t, _mm_set1_ps(maxLambda)));
+
+    _mm_storeu_ps(lambdas + offset, t);
+    _mm_storeu_ps(us + offset, u);
+    _mm_storeu_ps(vs + offset, v);
+    return _mm_movemask_ps(valid) << offset;
+}
+
+#endif
+
+}  // namespace
+
+int intersectTrianglePacket(const TrianglePacket& packet, const vec3& origin, const vec3& dir,
+                            float maxLambda, float& lambda, float& u, float& v) {
+#if defined(LABRAYTRACER_X86)
+    const SimdLevel level = simdLevel();
+    if (level != SimdLevel::Scalar) {
+        float lambdas[TrianglePacket::Width], us[TrianglePacket::Width], vs[TrianglePacket::Width];
+        int mask = (level == SimdLevel::AVX)
+                       ? intersect8(packet, origin, dir, maxLambda, lambdas, us, vs)
+                       : intersect4(packet, 0, origin, dir, maxLambda, lambdas, us, vs) |
+                             intersect4(packet, 4, origin, dir, maxLambda, lambdas, us, vs);
+        mask &= (1 << packet.count) - 1;
+        return closestLane(mask, lambdas, us, vs, lambda, u, v);
+    }
+#endif
+    return intersectTrianglePacketScalar(packet, origin, dir, maxLambda, lambda, u, v);
+}
+
+int intersectTrianglePacketScalar(const TrianglePacket& packet, const vec3& origin,
+                                  const vec3& dir, float maxLambda, float& lambda, float& u,
+                                  float& v) {
+    float lambdas[TrianglePacket::Width], us[TrianglePacket::Width], vs[TrianglePacket::Width];
+    int mask = 0;
+    for (int lane(0); lane < packet.count; lane++) {
+        const vec3 p0(packet.p0x[lane], packet.p0y[lane], packet.p0z[lane]);
+        const vec3 e1(packet.e1x[lane], packet.e1y[lane], packet.e1z[lane]);
+        const vec3 e2(packet.e2x[lane], packet.e2y[lane], packet.e2z[lane]);
+        if (intersectTriangle(origin, dir, p0, e1, e2, maxLambda, lambdas[lane], us[lane],
+                              vs[lane])) {
+            mask |= 1 << lane;
+        }
+    }
+    return closestLane(mask, lambdas, us, vs, lambda, u, v);
+}
+
+}  // namespace Kernel
+
+}  // namespace inviwo
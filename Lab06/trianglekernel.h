@@ -0,0 +1,83 @@
+/*********************************************************************
+ *  Author  : Himangshu Saikia
+ *  Init    : Saturday, October 17, 2026 - 11:02:47
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#pragma once
+
+#include <labraytracer/labraytracermoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+namespace inviwo {
+
+namespace Kernel {
+
+/*  Determinants below this magnitude mean the ray is parallel to the triangle plane.
+*/
+constexpr float TriangleDetEpsilon = 1e-12f;
+
+/*  Moeller-Trumbore ray/triangle test on precomputed edges.
+
+    The triangle is given by its first vertex p0 and the edges e1 = p1 - p0, e2 = p2 - p0.
+    On a hit in [0, maxLambda], lambda holds the ray parameter and (u, v) the barycentric
+    coordinates of p1 and p2.
+
+    All arithmetic is spelled out per component in the same order as the packet kernel, and
+    trianglekernel.cpp is compiled without contracting multiplies and adds into FMA
+    instructions. Scalar and packet kernel therefore round identically and give bit-identical
+    hit decisions, lambda, u and v, also for rays that graze an edge or end at maxLambda.
+*/
+IVW_MODULE_LABRAYTRACER_API bool intersectTriangle(const vec3& origin, const vec3& dir,
+                                                   const vec3& p0, const vec3& e1, const vec3& e2,
+                                                   float maxLambda, float& lambda, float& u,
+                                                   float& v);
+
+/** \class TrianglePacket
+    \brief Eight triangles in structure-of-arrays layout for the packet kernel.
+
+    Unused lanes keep zero edges, which makes their determinant zero so they never hit.
+
+    @author Himangshu Saikia
+*/
+struct IVW_MODULE_LABRAYTRACER_API TrianglePacket {
+    static constexpr int Width = 8;
+
+    alignas(32) float p0x[Width] = {};
+    alignas(32) float p0y[Width] = {};
+    alignas(32) float p0z[Width] = {};
+    alignas(32) float e1x[Width] = {};
+    alignas(32) float e1y[Width] = {};
+    alignas(32) float e1z[Width] = {};
+    alignas(32) float e2x[Width] = {};
+    alignas(32) float e2y[Width] = {};
+    alignas(32) float e2z[Width] = {};
+    int count = 0;
+
+    void set(int lane, const vec3& p0, const vec3& e1, const vec3& e2);
+};
+
+/*  Tests one ray against all triangles of the packet at once, with AVX or SSE2 lanes as
+    chosen by Kernel::simdLevel(), and with the scalar kernel on other CPUs.
+
+    Returns the lane of the closest hit in [0, maxLambda] or -1. Ties go to the lower lane.
+*/
+IVW_MODULE_LABRAYTRACER_API int intersectTrianglePacket(const TrianglePacket& packet,
+                                                        const vec3& origin, const vec3& dir,
+                                                        float maxLambda, float& lambda, float& u,
+                                                        float& v);
+
+/*  Scalar reference implementation of intersectTrianglePacket.
+*/
+IVW_MODULE_LABRAYTRACER_API int intersectTrianglePacketScalar(const TrianglePacket& packet,
+                                                              const vec3& origin,
+                                                              const vec3& dir, float maxLambda,
+                                                              float& lambda, float& u, float& v);
+
+}  // namespace Kernel
+
+}  // namespace inviwo
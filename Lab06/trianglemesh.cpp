@@ -0,0 +1,155 @@
+/*********************************************************************
+ *  Author  : Himangshu Saikia
+ *  Init    : Saturday, October 17, 2026 - 17:02:14
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#include <labraytracer/trianglemesh.h>
+#include <labraytracer/util.h>
+#include <algorithm>
+#include <limits>
+
+namespace inviwo {
+
+TriangleMesh::TriangleMesh(const std::vector<vec3>& vertices, std::vector<uint32_t> indices)
+    : indices_(std::move(indices)) {
+    ivwAssert(indices_.size() % 3 == 0, "Expected three indices per triangle.");
+
+    // Triangles that refer to missing vertices, and a trailing incomplete one, are dropped
+    // so that no query reads past the vertex arrays.
+    size_t numValid = 0;
+    for (size_t t(0); t + 3 <= indices_.size(); t += 3) {
+        const bool valid = indices_[t] < vertices.size() && indices_[t + 1] < vertices.size() &&
+                           indices_[t + 2] < vertices.size();
+        ivwAssert(valid, "Triangle index out of range of the vertices.");
+        if (!valid) continue;
+        for (size_t k(0); k < 3; k++) indices_[numValid++] = indices_[t + k];
+    }
+    indices_.resize(numValid);
+
+    x_.reserve(vertices.size());
+    y_.reserve(vertices.size());
+    z_.reserve(vertices.size());
+    for (const auto& vertex : vertices) {
+        x_.push_back(vertex.x);
+        y_.push_back(vertex.y);
+        z_.push_back(vertex.z);
+    }
+
+    std::vector<AABB> bounds(getNumTriangles());
+    for (size_t t(0); t < bounds.size(); t++) {
+        for (int k(0); k < 3; k++) bounds[t].extend(getVertex(indices_[3 * t + k]));
+    }
+    bvh_.build(bounds, Kernel::TrianglePacket::Width);
+
+    // Store the triangles in leaf order, so that a leaf is a contiguous range of them
+    std::vector<uint32_t> leafOrder(indices_.size());
+    for (size_t i(0); i < bvh_.indices().size(); i++) {
+        for (size_t k(0); k < 3; k++) leafOrder[3 * i + k] = indices_[3 * bvh_.indices()[i] + k];
+    }
+    indices_ = std::move(leafOrder);
+}
+
+void TriangleMesh::gatherPacket(uint32_t first, uint32_t count,
+                                Kernel::TrianglePacket& packet) const {
+    packet.count = static_cast<int>(count);
+    for (uint32_t lane(0); lane < count; lane++) {
+        const uint32_t triangle = first + lane;
+        const vec3 p0 = getVertex(indices_[3 * triangle]);
+        const vec3 p1 = getVertex(indices_[3 * triangle + 1]);
+        const vec3 p2 = getVertex(indices_[3 * triangle + 2]);
+        packet.set(static_cast<int>(lane), p0, p1 - p0, p2 - p0);
+    }
+}
+
+bool TriangleMesh::closestIntersection(const Ray& ray, double maxLambda,
+                                       RayIntersection& intersection) const {
+    constexpr uint32_t Width = Kernel::TrianglePacket::Width;
+    uint32_t hitTriangle = 0;
+    float hitLambda = 0, hitU = 0, hitV = 0;
+    const bool hit = bvh_.closestLeaf(ray, maxLambda, [&](uint32_t node, double& closest) {
+        const BVH::Node& leaf = bvh_.nodes()[node];
+        float maxLambdaF =
+            static_cast<float>(std::min(closest, double(std::numeric_limits<float>::max())));
+        bool hitLeaf = false;
+        // Leaves above the packet width only occur where the BVH could not split
+        for (uint32_t first(leaf.offset); first < leaf.offset + leaf.count; first += Width) {
+            Kernel::TrianglePacket packet;
+            gatherPacket(first, std::min(Width, leaf.offset + leaf.count - first), packet);
+            float lambda, u, v;
+            const int lane = Kernel::intersectTrianglePacket(
+                packet, ray.getOrigin(), ray.getDirection(), maxLambdaF, lambda, u, v);
+            if (lane < 0) continue;
+            hitTriangle = first + static_cast<uint32_t>(lane);
+            hitLambda = lambda;
+            hitU = u;
+            hitV = v;
+            maxLambdaF = lambda;
+            hitLeaf = true;
+        }
+        if (hitLeaf) closest = hitLambda;
+        return hitLeaf;
+    });
+    if (!hit) return false;
+
+    // Only the closest triangle gets a normal and an intersection record. The mesh has no
+    // texture coordinates, uvw are the barycentric coordinates of the hit.
+    const vec3 p0 = getVertex(indices_[3 * hitTriangle]);
+    const vec3 p1 = getVertex(indices_[3 * hitTriangle + 1]);
+    const vec3 p2 = getVertex(indices_[3 * hitTriangle + 2]);
+    const vec3 normal = glm::normalize(glm::cross(p1 - p0, p2 - p0));
+    const vec3 uvw(1.0f - hitU - hitV, hitU, hitV);
+    intersection = RayIntersection(ray, shared_from_this(), hitLambda, normal, uvw);
+    return true;
+}
+
+bool TriangleMesh::anyIntersection(const Ray& ray, double maxLambda) const {
+    constexpr uint32_t Width = Kernel::TrianglePacket::Width;
+    const float maxLambdaF =
+        static_cast<float>(std::min(maxLambda, double(std::numeric_limits<float>::max())));
+    return bvh_.anyLeaf(ray, maxLambda, [&](uint32_t node, double) {
+        const BVH::Node& leaf = bvh_.nodes()[node];
+        for (uint32_t first(leaf.offset); first < leaf.offset + leaf.count; first += Width) {
+            Kernel::TrianglePacket packet;
+            gatherPacket(first, std::min(Width, leaf.offset + leaf.count - first), packet);
+            float lambda, u, v;
+            if (Kernel::intersectTrianglePacket(packet, ray.getOrigin(), ray.getDirection(),
+                                                maxLambdaF, lambda, u, v) >= 0) {
+                return true;
+            }
+        }
+        return false;
+    });
+}
+
+AABB TriangleMesh::getBoundingBox() const {
+    if (bvh_.empty()) return AABB();
+    return bvh_.nodes()[0].bounds;
+}
+
+void TriangleMesh::addToSignature(SceneSignature& signature) const {
+    for (size_t i(0); i < x_.size(); i++) {
+        signature.add(getVertex(static_cast<uint32_t>(i)));
+    }
+    for (auto index : indices_) signature.add(uint64_t(index));
+}
+
+void TriangleMesh::drawGeometry(std::shared_ptr<BasicMesh> mesh,
+                                std::vector<BasicMesh::Vertex>& vertices) const {
+    auto indexBuffer = mesh->addIndexBuffer(DrawType::Lines, ConnectivityType::None);
+
+    for (size_t t(0); t < getNumTriangles(); t++) {
+        const vec3 p0 = getVertex(indices_[3 * t]);
+        const vec3 p1 = getVertex(indices_[3 * t + 1]);
+        const vec3 p2 = getVertex(indices_[3 * t + 2]);
+        Util::drawLineSegment(p0, p1, vec4(0.2, 0.2, 0.2, 1), indexBuffer.get(), vertices);
+        Util::drawLineSegment(p1, p2, vec4(0.2, 0.2, 0.2, 1), indexBuffer.get(), vertices);
+        Util::drawLineSegment(p2, p0, vec4(0.2, 0.2, 0.2, 1), indexBuffer.get(), vertices);
+    }
+}
+
+}  // namespace inviwo
@@ -0,0 +1,75 @@
+/*********************************************************************
+ *  Author  : Himangshu Saikia
+ *  Init    : Saturday, October 17, 2026 - 17:02:14
+ *
+ *  Project : KTH Inviwo Modules
+ *
+ *  License : Follows the Inviwo BSD license model
+ *********************************************************************
+ */
+
+#pragma once
+
+#include <labraytracer/labraytracermoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <labraytracer/renderable.h>
+#include <labraytracer/bvh.h>
+#include <labraytracer/trianglekernel.h>
+#include <cstdint>
+
+namespace inviwo {
+
+/** \class TriangleMesh
+    \brief Indexed triangle mesh as a single renderable.
+
+    Vertex positions are stored as three float arrays and triangles as one array of
+    vertex indices, i.e. 12 bytes per vertex and 12 bytes per triangle, plus the BVH
+    over the triangles through which all intersection queries go (4 bytes per triangle
+    and its nodes).
+
+    The triangles are stored in the leaf order of the BVH and its leaves hold up to eight
+    triangles. A visited leaf is gathered into a triangle packet on the stack, so it
+    costs one call of the packet kernel without keeping a copy of the triangles.
+
+    @author Himangshu Saikia
+*/
+class IVW_MODULE_LABRAYTRACER_API TriangleMesh : public Renderable {
+    //Friends
+    //Types
+public:
+
+    //Construction / Deconstruction
+public:
+    TriangleMesh() = default;
+    /// indices holds three vertex indices per triangle. Triangles with an index out of range
+    /// of vertices are dropped.
+    TriangleMesh(const std::vector<vec3>& vertices, std::vector<uint32_t> indices);
+    virtual ~TriangleMesh() = default;
+
+    //Methods
+public:
+    bool closestIntersection(const Ray& ray, double maxLambda, RayIntersection& intersection) const
+    override;
+    bool anyIntersection(const Ray& ray, double maxLambda) const override;
+    AABB getBoundingBox() const override;
+    void addToSignature(SceneSignature& signature) const override;
+    void drawGeometry(std::shared_ptr<BasicMesh> mesh,
+                      std::vector<BasicMesh::Vertex>& vertices) const override;
+
+    size_t getNumVertices() const { return x_.size(); }
+    size_t getNumTriangles() const { return indices_.size() / 3; }
+    vec3 getVertex(uint32_t i) const { return vec3(x_[i], y_[i], z_[i]); }
+
+private:
+    /// Gathers the count triangles from first on into packet.
+    void gatherPacket(uint32_t first, uint32_t count, Kernel::TrianglePacket& packet) const;
+
+    //Attributes
+private:
+    std::vector<float> x_, y_, z_;
+    // In BVH leaf order, a leaf covers the triangles [offset, offset + count)
+    std::vector<uint32_t> indices_;
+    BVH bvh_;
+};
+
+} // namespace